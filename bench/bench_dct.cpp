@@ -0,0 +1,77 @@
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "wm/transform/dct.h"
+#include "wm/transform/dct_basis.h"
+
+using namespace wm;
+
+using Kernel = void (*)(const float*, float*);
+
+// ----------------------------
+// Time one kernel over a block pool
+// ----------------------------
+static double ns_per_block(Kernel fn,
+                           const std::vector<float>& in,
+                           std::vector<float>& out,
+                           uint32_t iterations)
+{
+    const uint32_t blocks = uint32_t(in.size() / 64);
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (uint32_t it = 0; it < iterations; ++it)
+        for (uint32_t b = 0; b < blocks; ++b)
+            fn(&in[b * 64], &out[b * 64]);
+    auto t1 = std::chrono::steady_clock::now();
+
+    double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+    return ns / (double(blocks) * iterations);
+}
+
+// Masked coefficients only, as used by extraction
+static void masked_mid_freq(const float* in, float* out) {
+    analyze_masked(in, 8, mid_freq_basis(), out);
+}
+
+int main() {
+    constexpr uint32_t BLOCKS = 1024;
+
+    std::vector<float> in(BLOCKS * 64);
+    std::vector<float> out(BLOCKS * 64);
+
+    for (uint32_t i = 0; i < in.size(); ++i)
+        in[i] = float((i * 37) % 255);
+
+    struct Case {
+        const char* name;
+        Kernel fn;
+        uint32_t iterations;
+        bool reference;
+        bool inverse;
+    };
+
+    const Case cases[] = {
+        { "dct8x8_reference",  dct8x8_reference,    4, true,  false },
+        { "dct8x8_separable",  dct8x8_separable,   64, false, false },
+        { "dct8x8 (AAN)",      dct8x8,            256, false, false },
+        { "analyze_masked",    masked_mid_freq,   256, false, false },
+        { "idct8x8_reference", idct8x8_reference,   4, true,  true  },
+        { "idct8x8_separable", idct8x8_separable,  64, false, true  },
+        { "idct8x8 (AAN)",     idct8x8,           256, false, true  },
+    };
+
+    double ref_fwd = 0.0, ref_inv = 0.0;
+
+    for (const Case& c : cases) {
+        double ns = ns_per_block(c.fn, in, out, c.iterations);
+
+        if (c.reference)
+            (c.inverse ? ref_inv : ref_fwd) = ns;
+
+        double ref = c.inverse ? ref_inv : ref_fwd;
+        printf("%-20s | %10.1f ns/block | %7.1fx\n", c.name, ns, ref / ns);
+    }
+
+    return 0;
+}
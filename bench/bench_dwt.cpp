@@ -0,0 +1,47 @@
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "wm/transform/dwt.h"
+
+using namespace wm;
+
+// ----------------------------
+// Forward + inverse 2-level Haar at several widths
+// ----------------------------
+int main() {
+    struct Size {
+        uint32_t w;
+        uint32_t h;
+    };
+
+    const Size sizes[] = {
+        { 1024, 1024 },
+        { 2048, 1536 },
+        { 4000, 3000 },
+        { 8000, 1500 },
+    };
+
+    for (const Size& s : sizes) {
+        std::vector<float> img(size_t(s.w) * s.h);
+        for (size_t i = 0; i < img.size(); ++i)
+            img[i] = float(i % 251);
+
+        std::vector<float> scratch(dwt_scratch_size(s.w, s.h));
+
+        auto t0 = std::chrono::steady_clock::now();
+        dwt2_haar(img.data(), s.w, s.h, scratch.data());
+        auto t1 = std::chrono::steady_clock::now();
+        idwt2_haar(img.data(), s.w, s.h, scratch.data());
+        auto t2 = std::chrono::steady_clock::now();
+
+        double fwd = std::chrono::duration<double, std::milli>(t1 - t0).count();
+        double inv = std::chrono::duration<double, std::milli>(t2 - t1).count();
+        double mpix = double(s.w) * s.h / 1e6;
+
+        printf("%5ux%-5u | fwd %7.2f ms | inv %7.2f ms | %6.1f Mpix/s\n",
+               s.w, s.h, fwd, inv, 2.0 * mpix / ((fwd + inv) / 1e3));
+    }
+
+    return 0;
+}
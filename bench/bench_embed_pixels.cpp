@@ -0,0 +1,78 @@
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "wm/api.h"
+
+// ----------------------------
+// 8-bit embedding: float plane round trip vs fused wm_embed_pixels
+// ----------------------------
+// The round trip is what an integrator writes by hand: a scalar BT.601
+// plane, wm_embed_ex, then the luminance change added back to each channel.
+static void round_trip(uint8_t* px, uint32_t W, uint32_t H, uint32_t bpp,
+                       const WM_Payload* payload, uint64_t key,
+                       const WM_EmbedOptions* options)
+{
+    const size_t n = size_t(W) * H;
+    std::vector<float> Y(n), Y0(n);
+
+    for (size_t i = 0; i < n; ++i) {
+        const uint8_t* p = px + i * bpp;
+        Y[i] = 0.299f * p[0] + 0.587f * p[1] + 0.114f * p[2];
+    }
+    Y0 = Y;
+
+    WM_Image img{ W, H, Y.data() };
+    wm_embed_ex(&img, payload, key, 2.0f, options);
+
+    for (size_t i = 0; i < n; ++i) {
+        float d = Y[i] - Y0[i];
+        for (uint32_t c = 0; c < 3; ++c) {
+            float v = std::nearbyint(px[i * bpp + c] + d);
+            px[i * bpp + c] = uint8_t(v < 0 ? 0 : (v > 255 ? 255 : v));
+        }
+    }
+}
+
+int main() {
+    const uint32_t W = 4000, H = 3008;
+    constexpr uint32_t PAYLOAD_LEN = 64;
+    const uint64_t KEY = 0xC0FFEEULL;
+
+    int8_t bits[PAYLOAD_LEN];
+    for (uint32_t i = 0; i < PAYLOAD_LEN; ++i)
+        bits[i] = (i * 7 % 3) ? 1 : -1;
+    WM_Payload payload{ bits, PAYLOAD_LEN };
+
+    WM_EmbedOptions one{};
+    one.threads = 1;
+
+    const uint32_t formats[2] = { WM_PIXEL_RGB8, WM_PIXEL_BGRA8 };
+    const char* names[2] = { "RGB8 ", "BGRA8" };
+
+    for (uint32_t k = 0; k < 2; ++k) {
+        const uint32_t bpp = k == 0 ? 3 : 4;
+        std::vector<uint8_t> base(size_t(W) * H * bpp);
+        for (size_t i = 0; i < base.size(); ++i)
+            base[i] = uint8_t(128 + 60 * std::sin(0.001f * float(i)));
+
+        std::vector<uint8_t> px = base;
+        auto t0 = std::chrono::steady_clock::now();
+        round_trip(px.data(), W, H, bpp, &payload, KEY, &one);
+        auto t1 = std::chrono::steady_clock::now();
+
+        px = base;
+        WM_PixelBuffer buf{ W, H, W * bpp, formats[k], px.data() };
+        auto t2 = std::chrono::steady_clock::now();
+        wm_embed_pixels(&buf, &payload, KEY, 2.0f, &one);
+        auto t3 = std::chrono::steady_clock::now();
+
+        printf("%s %ux%u | float round trip %7.2f ms | fused %7.2f ms\n",
+               names[k], W, H,
+               std::chrono::duration<double, std::milli>(t1 - t0).count(),
+               std::chrono::duration<double, std::milli>(t3 - t2).count());
+    }
+
+    return 0;
+}
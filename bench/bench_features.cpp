@@ -0,0 +1,81 @@
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "wm/api.h"
+
+// ----------------------------
+// Re-verification: decode the image vs map its saved features
+// ----------------------------
+int main() {
+    const uint32_t W = 4000, H = 3008;
+    constexpr uint32_t PAYLOAD_LEN = 64;
+    const uint64_t KEY = 0xC0FFEEULL;
+    const char* path = "bench_features.wmf";
+    const int runs = 20;
+
+    std::vector<float> Y(size_t(W) * H);
+    for (uint32_t y = 0; y < H; ++y)
+        for (uint32_t x = 0; x < W; ++x)
+            Y[size_t(y) * W + x] =
+                128.0f + 40.0f * std::sin(0.01f * x) * std::cos(0.013f * y);
+
+    int8_t bits[PAYLOAD_LEN];
+    for (uint32_t i = 0; i < PAYLOAD_LEN; ++i)
+        bits[i] = (i * 7 % 3) ? 1 : -1;
+    WM_Payload payload{ bits, PAYLOAD_LEN };
+
+    WM_Image img{ W, H, Y.data() };
+    wm_embed(&img, &payload, KEY, 2.0f);
+
+    WM_ExtractOptions one{};
+    one.threads = 1;
+
+    WM_Features* features = nullptr;
+    auto t0 = std::chrono::steady_clock::now();
+    wm_features_compute(&img, &one, &features);
+    auto t1 = std::chrono::steady_clock::now();
+    wm_features_save(features, path);
+
+    const void* data = nullptr;
+    size_t size = 0;
+    wm_features_bytes(features, &data, &size);
+
+    WM_Context* ctx = nullptr;
+    wm_context_create(W, H, PAYLOAD_LEN, KEY, nullptr, &ctx);
+
+    int8_t out[PAYLOAD_LEN];
+    float conf[PAYLOAD_LEN];
+    WM_ExtractResult result{};
+    result.bits = out;
+    result.confidence = conf;
+    result.length = PAYLOAD_LEN;
+
+    auto t2 = std::chrono::steady_clock::now();
+    for (int r = 0; r < runs; ++r)
+        wm_extract_ctx(ctx, &img, &result, &one);
+    auto t3 = std::chrono::steady_clock::now();
+    for (int r = 0; r < runs; ++r) {
+        WM_Features* mapped = nullptr;
+        wm_features_map(path, &mapped);
+        wm_extract_features_ctx(ctx, mapped, &result);
+        wm_features_destroy(mapped);
+    }
+    auto t4 = std::chrono::steady_clock::now();
+
+    auto ms = [](auto a, auto b) {
+        return std::chrono::duration<double, std::milli>(b - a).count();
+    };
+
+    printf("%ux%u: features %.2f ms, %zu bytes (plane %zu bytes)\n",
+           W, H, ms(t0, t1), size, size_t(W) * H * sizeof(float));
+    printf("extract from image        : %7.3f ms\n", ms(t2, t3) / runs);
+    printf("map + extract from features: %7.3f ms (verdict %d)\n",
+           ms(t3, t4) / runs, result.verdict);
+
+    wm_context_destroy(ctx);
+    wm_features_destroy(features);
+    std::remove(path);
+    return 0;
+}
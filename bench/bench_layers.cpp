@@ -0,0 +1,59 @@
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "wm/api.h"
+
+// ----------------------------
+// N layers: one wm_embed_ex per layer vs wm_embed_layers
+// ----------------------------
+int main() {
+    const uint32_t W = 4000, H = 3008;
+    constexpr uint32_t PAYLOAD_LEN = 64;
+    constexpr uint32_t MAX_LAYERS = 4;
+
+    std::vector<float> base(size_t(W) * H);
+    for (uint32_t y = 0; y < H; ++y)
+        for (uint32_t x = 0; x < W; ++x)
+            base[size_t(y) * W + x] =
+                128.0f + 40.0f * std::sin(0.01f * x) * std::cos(0.013f * y);
+
+    int8_t bits[MAX_LAYERS][PAYLOAD_LEN];
+    WM_Payload payloads[MAX_LAYERS];
+    WM_EmbedLayer layers[MAX_LAYERS];
+    for (uint32_t l = 0; l < MAX_LAYERS; ++l) {
+        for (uint32_t i = 0; i < PAYLOAD_LEN; ++i)
+            bits[l][i] = ((i + l) * 7 % 3) ? 1 : -1;
+        payloads[l] = WM_Payload{ bits[l], PAYLOAD_LEN };
+        layers[l] = WM_EmbedLayer{ 100 + l, &payloads[l], 2.0f, nullptr };
+    }
+
+    WM_EmbedOptions one{};
+    one.threads = 1;
+
+    std::vector<float> Y;
+    WM_Image img{ W, H, nullptr };
+
+    for (uint32_t n = 1; n <= MAX_LAYERS; n *= 2) {
+        Y = base;
+        img.y = Y.data();
+        auto t0 = std::chrono::steady_clock::now();
+        for (uint32_t l = 0; l < n; ++l)
+            wm_embed_ex(&img, &payloads[l], layers[l].key, 2.0f, &one);
+        auto t1 = std::chrono::steady_clock::now();
+
+        Y = base;
+        img.y = Y.data();
+        auto t2 = std::chrono::steady_clock::now();
+        wm_embed_layers(&img, layers, n, &one);
+        auto t3 = std::chrono::steady_clock::now();
+
+        printf("%u layer(s) | sequential %7.2f ms | single pass %7.2f ms\n",
+               n,
+               std::chrono::duration<double, std::milli>(t1 - t0).count(),
+               std::chrono::duration<double, std::milli>(t3 - t2).count());
+    }
+
+    return 0;
+}
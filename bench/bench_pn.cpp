@@ -0,0 +1,53 @@
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "wm/watermark/pn.h"
+
+using namespace wm;
+
+// ----------------------------
+// PN sign masks for one block per entry: v1 (per chip) vs v2 (packed)
+// ----------------------------
+int main() {
+    const uint32_t N = 1u << 20;
+    const uint64_t key = 0x0123456789ABCDEFULL;
+
+    std::vector<uint32_t> bits(N);
+    for (uint32_t i = 0; i < N; ++i)
+        bits[i] = (i * 2654435761u) % 64;
+
+    std::vector<uint8_t> masks(N);
+    uint32_t check = 0;
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < N; ++i)
+        masks[i] = pn_mask(key, bits[i], i);
+    auto t1 = std::chrono::steady_clock::now();
+    for (uint8_t m : masks) check += m;
+
+    pn_masks(key, bits.data(), 0, N, masks.data());
+    auto t1b = std::chrono::steady_clock::now();
+    for (uint8_t m : masks) check += m;
+
+    for (uint32_t i = 0; i < N; ++i)
+        masks[i] = pn_mask_v2(key, bits[i], i);
+    auto t2 = std::chrono::steady_clock::now();
+    for (uint8_t m : masks) check += m;
+
+    pn_masks_v2(key, bits.data(), 0, N, masks.data());
+    auto t3 = std::chrono::steady_clock::now();
+    for (uint8_t m : masks) check += m;
+
+    auto ns = [&](auto a, auto b) {
+        return std::chrono::duration<double, std::nano>(b - a).count() / N;
+    };
+
+    printf("v1 per chip      : %6.2f ns/block\n", ns(t0, t1));
+    printf("v1 per chip batch: %6.2f ns/block\n", ns(t1, t1b));
+    printf("v2 packed scalar : %6.2f ns/block\n", ns(t1b, t2));
+    printf("v2 packed batch  : %6.2f ns/block\n", ns(t2, t3));
+    printf("(checksum %u)\n", check);
+
+    return 0;
+}
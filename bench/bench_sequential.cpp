@@ -0,0 +1,78 @@
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "wm/api.h"
+
+// ----------------------------
+// Full extraction vs sequential early exit vs presence pre-screen,
+// marked and unmarked
+// ----------------------------
+int main() {
+    const uint32_t W = 4000, H = 3008;
+    constexpr uint32_t PAYLOAD_LEN = 64;
+    const uint64_t KEY = 0xC0FFEEULL;
+
+    int8_t bits[PAYLOAD_LEN];
+    for (uint32_t i = 0; i < PAYLOAD_LEN; ++i)
+        bits[i] = (i * 7 % 3) ? 1 : -1;
+    WM_Payload payload{ bits, PAYLOAD_LEN };
+
+    std::vector<float> marked(size_t(W) * H);
+    for (uint32_t y = 0; y < H; ++y)
+        for (uint32_t x = 0; x < W; ++x)
+            marked[size_t(y) * W + x] =
+                128.0f + 40.0f * std::sin(0.01f * x) * std::cos(0.013f * y);
+    std::vector<float> unmarked = marked;
+
+    WM_Image img_m{ W, H, marked.data() };
+    WM_Image img_u{ W, H, unmarked.data() };
+    wm_embed(&img_m, &payload, KEY, 2.0f);
+
+    WM_Context* ctx = nullptr;
+    wm_context_create(W, H, PAYLOAD_LEN, KEY, nullptr, &ctx);
+
+    int8_t out[PAYLOAD_LEN];
+    float conf[PAYLOAD_LEN];
+    WM_ExtractResult result{};
+    result.bits = out;
+    result.confidence = conf;
+    result.length = PAYLOAD_LEN;
+
+    WM_ExtractOptions one{};
+    one.threads = 1;
+
+    const uint32_t total = (W / 32) * (H / 32) * 2;
+    const WM_Image* images[2] = { &img_m, &img_u };
+    const char* names[2] = { "marked  ", "unmarked" };
+
+    for (uint32_t i = 0; i < 2; ++i) {
+        auto t0 = std::chrono::steady_clock::now();
+        wm_extract_ctx(ctx, images[i], &result, &one);
+        auto t1 = std::chrono::steady_clock::now();
+        int full = result.verdict;
+
+        uint32_t read = 0;
+        wm_extract_sequential_ctx(ctx, images[i], &result, nullptr, &read);
+        auto t2 = std::chrono::steady_clock::now();
+
+        WM_PresenceResult presence{};
+        wm_detect_presence_ctx(ctx, images[i], nullptr, &presence);
+        auto t3 = std::chrono::steady_clock::now();
+
+        printf("%s | full %7.2f ms (verdict %d) | sequential %7.2f ms "
+               "(verdict %d, %u of %u blocks) | presence %7.2f ms "
+               "(bound %.1e, %u blocks)\n",
+               names[i],
+               std::chrono::duration<double, std::milli>(t1 - t0).count(),
+               full,
+               std::chrono::duration<double, std::milli>(t2 - t1).count(),
+               result.verdict, read, total,
+               std::chrono::duration<double, std::milli>(t3 - t2).count(),
+               presence.false_positive_bound, presence.blocks_read);
+    }
+
+    wm_context_destroy(ctx);
+    return 0;
+}
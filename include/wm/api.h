@@ -1,5 +1,7 @@
 #pragma once
+#include <stddef.h>
 #include <stdint.h>
+#include "types.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -11,7 +13,8 @@ typedef enum {
     WM_ERR_INVALID_DIMENSIONS,
     WM_ERR_INSUFFICIENT_CAPACITY,
     WM_ERR_INTERNAL,
-    WM_ERR_UNVERIFIABLE
+    WM_ERR_UNVERIFIABLE,
+    WM_ERR_IO
 } WM_Status;
 
 typedef enum {
@@ -50,11 +53,425 @@ WM_Status wm_embed(
 );
 
 WM_Status wm_extract(
+    const WM_Image* image,
+    uint64_t key,
+    WM_ExtractResult* result
+);
+
+// ----------------------------
+// Soft-decision results
+// ----------------------------
+// Extension of WM_ExtractResult for the soft-decision calls. `base` comes
+// first and WM_ExtractResult itself is unchanged, so existing callers are
+// unaffected and &r.base works with every other call. struct_size lets
+// later versions append fields.
+//
+// Per bit, the raw correlations of its blocks are combined into a score
+// z = sum(c) / sqrt(sum(c²)), about N(0, 1) without a watermark.
+// base.bits = sign(z), base.confidence = erf(|z| / sqrt 2), and the
+// verdict is derived from these confidences as usual.
+typedef struct {
+    WM_ExtractResult base;
+    uint32_t struct_size;     // caller sets sizeof(WM_ExtractResultSoft)
+
+    float* scores;            // per-bit z, base.length entries; may be NULL
+
+    float mean_abs_score;     // mean |z|
+    float min_abs_score;      // weakest |z|
+    float detection_z;        // (sum z² - n) / sqrt(2n): ~N(0, 1) unmarked
+} WM_ExtractResultSoft;
+
+// Same as wm_embed / wm_extract with explicit options (NULL = defaults).
+// Output does not depend on the thread count.
+WM_Status wm_embed_ex(
     WM_Image* image,
+    const WM_Payload* payload,
+    uint64_t key,
+    float alpha,
+    const WM_EmbedOptions* options
+);
+
+WM_Status wm_extract_ex(
+    const WM_Image* image,
+    uint64_t key,
+    WM_ExtractResult* result,
+    const WM_ExtractOptions* options
+);
+
+// Soft-decision extraction (see WM_ExtractResultSoft)
+WM_Status wm_extract_soft(
+    const WM_Image* image,
+    uint64_t key,
+    WM_ExtractResultSoft* result,
+    const WM_ExtractOptions* options  // NULL = defaults
+);
+
+// ----------------------------
+// Contexts
+// ----------------------------
+// Everything that depends only on (width, height, payload_len, key) —
+// key permutation, block address table, PN sign tables — computed once.
+// A context is immutable after creation and may be shared by any number
+// of threads; calls through it do no per-call setup.
+typedef struct WM_Context WM_Context;
+
+WM_Status wm_context_create(
+    uint32_t width,
+    uint32_t height,
+    uint32_t payload_len,
+    uint64_t key,
+    const WM_Scheme* scheme,        // NULL = v1
+    WM_Context** out
+);
+
+void wm_context_destroy(WM_Context* ctx);
+
+// Image dimensions must match the context (WM_ERR_INVALID_DIMENSIONS
+// otherwise) and payload/result length must equal payload_len. The
+// context's scheme applies; options->scheme is ignored.
+WM_Status wm_embed_ctx(
+    const WM_Context* ctx,
+    WM_Image* image,
+    const WM_Payload* payload,
+    float alpha,
+    const WM_EmbedOptions* options  // NULL = defaults
+);
+
+WM_Status wm_extract_ctx(
+    const WM_Context* ctx,
+    const WM_Image* image,
+    WM_ExtractResult* result,
+    const WM_ExtractOptions* options  // NULL = defaults
+);
+
+WM_Status wm_extract_soft_ctx(
+    const WM_Context* ctx,
+    const WM_Image* image,
+    WM_ExtractResultSoft* result,
+    const WM_ExtractOptions* options  // NULL = defaults
+);
+
+// ----------------------------
+// Multi-key extraction
+// ----------------------------
+// Checks one image against several keys. The key-independent part of
+// extraction (DWT and masked DCT analysis of every block) runs once; each
+// key then only permutes, applies its PN signs and votes. results[i] and
+// statuses[i] are what wm_extract_ex would give for keys[i] (results may
+// have different lengths). ranking, if not NULL, receives the key
+// indices ordered by decreasing mean confidence, then min confidence;
+// keys whose status is not WM_OK come last. The transform is split over
+// options->threads threads, then keys are. options->mode is ignored.
+WM_Status wm_extract_multikey(
+    const WM_Image* image,
+    const uint64_t* keys,
+    uint32_t key_count,
+    WM_ExtractResult* results,        // one per key, caller-allocated
+    uint32_t* ranking,                // key_count entries, may be NULL
+    const WM_ExtractOptions* options, // NULL = defaults
+    WM_Status* statuses               // one per key
+);
+
+// ----------------------------
+// Feature files
+// ----------------------------
+// The masked mid-frequency coefficients of every block (7 floats per
+// block, about 1/146 of the luminance plane) are the only image data that
+// extraction reads. A WM_Features holds them in a versioned file image —
+// 64-byte header, then the floats — that can be saved, memory-mapped and
+// verified against any key or payload length without the image.
+// Verification from features gives exactly the wm_extract_ex result.
+// Feature sets are immutable and may be shared across threads.
+typedef struct WM_Features WM_Features;
+
+// Width and height must be multiples of 32. Only options->threads is used.
+WM_Status wm_features_compute(
+    const WM_Image* image,
+    const WM_ExtractOptions* options,   // NULL = defaults
+    WM_Features** out
+);
+
+// View over a file image already in memory (no copy). `data` must stay
+// valid and unchanged until the features are destroyed. A malformed,
+// truncated or other-version image is WM_ERR_INVALID_ARGUMENT.
+WM_Status wm_features_open(
+    const void* data,
+    size_t size,
+    WM_Features** out
+);
+
+// Maps the file read-only (WM_ERR_IO if it cannot be read)
+WM_Status wm_features_map(const char* path, WM_Features** out);
+
+WM_Status wm_features_save(const WM_Features* features, const char* path);
+
+// The file image, e.g. to store it elsewhere
+WM_Status wm_features_bytes(
+    const WM_Features* features,
+    const void** data,
+    size_t* size
+);
+
+void wm_features_destroy(WM_Features* features);
+
+// wm_extract_ex on the image the features came from; only
+// options->scheme of `options` is used
+WM_Status wm_extract_features(
+    const WM_Features* features,
     uint64_t key,
+    WM_ExtractResult* result,
+    const WM_ExtractOptions* options    // NULL = defaults
+);
+
+WM_Status wm_extract_features_ctx(
+    const WM_Context* ctx,
+    const WM_Features* features,
     WM_ExtractResult* result
 );
 
+// ----------------------------
+// Sequential (early-exit) verification
+// ----------------------------
+// Reads blocks round by round in key order — one block of every bit per
+// round — and stops as soon as a sequential probability ratio test
+// reaches VERIFIED or TAMPERED within the bounds in `seq`. Clearly marked
+// and clearly unmarked images decide after a fraction of the blocks.
+// If every block is read without a decision the verdict follows the
+// usual thresholds. Bits and confidences describe the blocks read;
+// *blocks_read (optional) receives their count. Runs on the calling
+// thread; only options->scheme of `options` is used by the key variant.
+WM_Status wm_extract_sequential(
+    const WM_Image* image,
+    uint64_t key,
+    WM_ExtractResult* result,
+    const WM_ExtractOptions* options,   // NULL = defaults
+    const WM_SequentialOptions* seq,    // NULL = defaults
+    uint32_t* blocks_read
+);
+
+WM_Status wm_extract_sequential_ctx(
+    const WM_Context* ctx,
+    const WM_Image* image,
+    WM_ExtractResult* result,
+    const WM_SequentialOptions* seq,    // NULL = defaults
+    uint32_t* blocks_read
+);
+
+// ----------------------------
+// Presence pre-screen
+// ----------------------------
+// Cheap "is this key's watermark here at all?" test for triage before
+// the full decoder. Samples blocks_per_bit key-derived blocks of every
+// bit (reading only their 32×32 tiles) and runs one global correlation
+// test over them. The payload need not be known.
+typedef struct {
+    float score;                  // ~N(0, 1) unmarked, large when marked
+    float false_positive_bound;   // upper bound on P(score | unmarked)
+    uint32_t blocks_read;
+} WM_PresenceResult;
+
+// Runs on the calling thread; only options->scheme of `options` is used.
+WM_Status wm_detect_presence(
+    const WM_Image* image,
+    uint64_t key,
+    uint32_t payload_len,
+    const WM_ExtractOptions* options,    // NULL = defaults
+    const WM_PresenceOptions* presence,  // NULL = defaults
+    WM_PresenceResult* result
+);
+
+WM_Status wm_detect_presence_ctx(
+    const WM_Context* ctx,
+    const WM_Image* image,
+    const WM_PresenceOptions* presence,  // NULL = defaults
+    WM_PresenceResult* result
+);
+
+// ----------------------------
+// 8-bit RGB embedding
+// ----------------------------
+// wm_embed on the BT.601 luminance of an RGB8, RGBA8 or BGRA8 image, in
+// place: tile by tile, Y is computed (SIMD), embedded, and the change in
+// Y is added to R, G and B with rounding and saturation; alpha is kept.
+// No float copy of the image is made. Width and height must be multiples
+// of 32; rows may be padded (pitch).
+WM_Status wm_embed_pixels(
+    WM_PixelBuffer* image,
+    const WM_Payload* payload,
+    uint64_t key,
+    float alpha,
+    const WM_EmbedOptions* options  // NULL = defaults
+);
+
+// Same with a context (see wm_embed_ctx)
+WM_Status wm_embed_pixels_ctx(
+    const WM_Context* ctx,
+    WM_PixelBuffer* image,
+    const WM_Payload* payload,
+    float alpha,
+    const WM_EmbedOptions* options  // NULL = defaults
+);
+
+// ----------------------------
+// Multi-layer embedding
+// ----------------------------
+// Several independent watermarks (e.g. owner and distributor IDs under
+// different keys) in one pass: one forward and one inverse transform per
+// tile however many layers there are, so stamping N layers costs about as
+// much as one. Each layer extracts as if it had been embedded on its own
+// after the others (up to float rounding).
+typedef struct {
+    uint64_t key;
+    const WM_Payload* payload;
+    float alpha;
+    const WM_Context* context;  // optional prebuilt plan; key and
+                                // options->scheme are then ignored
+} WM_EmbedLayer;
+
+// strength_scale applies to every layer's alpha
+WM_Status wm_embed_layers(
+    WM_Image* image,
+    const WM_EmbedLayer* layers,
+    uint32_t count,
+    const WM_EmbedOptions* options  // NULL = defaults
+);
+
+// ----------------------------
+// Pattern cache
+// ----------------------------
+// For a fixed (context, payload, alpha) embedding always adds the same
+// image-independent plane P. A pattern computes P once; every
+// wm_embed_pattern is then Y += P, one streaming pass with no transform.
+// Output matches wm_embed_ctx up to float rounding (and half a
+// quantization step with WM_PATTERN_INT16). Patterns are immutable and
+// may be shared across threads.
+typedef struct WM_Pattern WM_Pattern;
+
+WM_Status wm_pattern_create(
+    const WM_Context* ctx,
+    const WM_Payload* payload,      // length must equal payload_len
+    float alpha,
+    uint32_t format,                // WM_PatternFormat
+    const WM_EmbedOptions* options, // NULL = defaults
+    WM_Pattern** out
+);
+
+void wm_pattern_destroy(WM_Pattern* pattern);
+
+// Image dimensions must match the pattern. Only options->threads is used.
+WM_Status wm_embed_pattern(
+    const WM_Pattern* pattern,
+    WM_Image* image,
+    const WM_EmbedOptions* options  // NULL = defaults
+);
+
+// ----------------------------
+// Fan-out
+// ----------------------------
+// Embed `count` payloads into one source plane, e.g. one per recipient.
+// Contributions are additive per bit, so fixed spatial templates are
+// combined with each payload's signs and added to the source: no
+// transform per output. Outputs match wm_embed_ctx on a copy of the
+// source up to float rounding.
+//
+// With `outputs` (count planes of width × height floats) every output is
+// written there, spread over options->threads threads. Otherwise
+// `callback` receives each output in payload order on the calling thread;
+// the plane is only valid during the call.
+typedef void (*WM_FanoutCallback)(uint32_t index, const float* y, void* user);
+
+WM_Status wm_embed_fanout(
+    const WM_Context* ctx,
+    const float* source,            // width × height, not modified
+    const WM_Payload* payloads,     // count, each of length payload_len
+    uint32_t count,
+    float alpha,
+    const WM_EmbedOptions* options, // NULL = defaults
+    float* const* outputs,          // count planes, or NULL
+    WM_FanoutCallback callback,     // used when outputs is NULL
+    void* user
+);
+
+// ----------------------------
+// Batches
+// ----------------------------
+// Process `count` images with one call. Images are spread over
+// options->threads threads (0 = serial) by a work-stealing scheduler,
+// largest first; each image runs on a single thread. statuses[i] receives
+// the status wm_embed / wm_extract would have returned for image i. The
+// call itself fails only for invalid array arguments.
+WM_Status wm_embed_batch(
+    WM_Image* images,
+    const WM_Payload* payloads,     // one per image
+    uint32_t count,
+    uint64_t key,
+    float alpha,
+    const WM_EmbedOptions* options, // NULL = defaults
+    WM_Status* statuses             // one per image
+);
+
+WM_Status wm_extract_batch(
+    const WM_Image* images,
+    uint32_t count,
+    uint64_t key,
+    WM_ExtractResult* results,        // one per image, caller-allocated
+    const WM_ExtractOptions* options, // NULL = defaults
+    WM_Status* statuses               // one per image
+);
+
+// ----------------------------
+// Row-band streaming
+// ----------------------------
+// The luminance plane is pushed top to bottom in bands of
+// WM_STREAM_BAND_ROWS rows × width floats (row stride = width), so pixel
+// memory stays bounded by one band regardless of image height. Results
+// are identical to wm_embed / wm_extract on the whole plane.
+//
+// Stream state depends on the scheme. With WM_PERMUTATION_V2_FEISTEL it
+// is constant. The default v1 shuffle cannot be inverted per block, so a
+// v1 stream keeps a 4-byte entry per 32×16 pixels (about 1/512 of the
+// float plane) and builds the full permutation once at create time.
+// Use v2 when state must not grow with image height.
+#define WM_STREAM_BAND_ROWS 32
+
+typedef struct WM_EmbedStream WM_EmbedStream;
+typedef struct WM_ExtractStream WM_ExtractStream;
+
+WM_Status wm_embed_stream_create(
+    uint32_t width,
+    uint32_t height,
+    const WM_Payload* payload,   // copied
+    uint64_t key,
+    float alpha,
+    const WM_Scheme* scheme,        // NULL = v1
+    WM_EmbedStream** out
+);
+
+// Embed the next band in place
+WM_Status wm_embed_stream_push(WM_EmbedStream* stream, float* band);
+
+void wm_embed_stream_destroy(WM_EmbedStream* stream);
+
+WM_Status wm_extract_stream_create(
+    uint32_t width,
+    uint32_t height,
+    uint32_t payload_len,
+    uint64_t key,
+    const WM_Scheme* scheme,        // NULL = v1
+    WM_ExtractStream** out
+);
+
+// Accumulate evidence from the next band (not modified)
+WM_Status wm_extract_stream_push(WM_ExtractStream* stream, const float* band);
+
+// Fill result once every band has been pushed
+WM_Status wm_extract_stream_finish(
+    WM_ExtractStream* stream,
+    WM_ExtractResult* result    // length must equal payload_len
+);
+
+void wm_extract_stream_destroy(WM_ExtractStream* stream);
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,4 +1,5 @@
 #pragma once
+#include <cstddef>
 #include "types.h"
 #include "api.h"
 
@@ -10,6 +11,40 @@ struct Image {
     float* Y;   // luminance channel
 };
 
+// --------------------------------
+// Interleaved 8-bit pixels
+// --------------------------------
+// Values match WM_PixelFormat
+enum class PixelFormat : uint8_t {
+    RGB8 = 0,
+    RGBA8 = 1,
+    BGRA8 = 2
+};
+
+inline uint32_t bytes_per_pixel(PixelFormat f) {
+    return f == PixelFormat::RGB8 ? 3u : 4u;
+}
+
+// Rows are `pitch` bytes apart (at least width × bytes_per_pixel)
+struct PixelImage {
+    uint32_t width;
+    uint32_t height;
+    size_t pitch;
+    PixelFormat format;
+    uint8_t* data;
+};
+
+// BT.601 luminance of `count` consecutive pixels. 8 pixels per AVX2
+// register when the host supports it; same values as the scalar loop.
+void luma_row(const uint8_t* pixels, PixelFormat format, uint32_t count,
+              float* y_out);
+
+// Adds delta[i] to R, G and B of pixel i, rounding to nearest and
+// saturating to [0, 255]; alpha is left as is. The weights sum to 1, so
+// this moves the luminance by delta up to the rounding.
+void add_luma_row(uint8_t* pixels, PixelFormat format, uint32_t count,
+                  const float* delta);
+
 WM_Status validate_image(const WM_ImageBuffer* img);
 Image to_luminance(const WM_ImageBuffer* img);
 void free_image(Image& img);
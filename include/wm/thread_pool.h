@@ -0,0 +1,78 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace wm {
+
+// Fixed set of worker threads used to split a single image across cores.
+// parallel_for blocks until done and the calling thread always takes part,
+// so nested or concurrent calls cannot deadlock even with every worker
+// busy. Work distribution never affects results: callers only split work
+// whose outputs do not overlap. If fn throws, the first exception is
+// rethrown on the caller after every thread has left fn; which other items
+// ran is unspecified.
+class ThreadPool {
+public:
+    explicit ThreadPool(uint32_t workers);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Process-wide pool with one worker per additional hardware thread,
+    // started on first use
+    static ThreadPool& shared();
+
+    // Workers plus the calling thread
+    uint32_t concurrency() const;
+
+    // Run fn(i) for every i in [0, count) on up to `threads` threads,
+    // including the caller. threads == 0 means concurrency().
+    void parallel_for(
+        uint32_t count,
+        uint32_t threads,
+        const std::function<void(uint32_t)>& fn
+    );
+
+    // Run fn(order[i]) for every i in [0, count) with per-thread deques
+    // and work stealing, for items of very different cost. Passing the
+    // most expensive items first gives the best balance.
+    void parallel_for_stealing(
+        const uint32_t* order,
+        uint32_t count,
+        uint32_t threads,
+        const std::function<void(uint32_t)>& fn
+    );
+
+private:
+    void worker_loop();
+
+    // Threads used for `count` items when `threads` are requested
+    uint32_t team_size(uint32_t threads, uint32_t count) const;
+
+    // Run body(slot) on the caller (slot 0) and up to threads - 1 helpers
+    void run_team(uint32_t threads, const std::function<void(uint32_t)>& body);
+
+    std::vector<std::thread> workers_;
+    std::deque<std::function<void()>> queue_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopping_ = false;
+};
+
+// Thread count actually used for `requested` (0 = all cores)
+uint32_t resolve_threads(uint32_t requested);
+
+// ThreadPool::shared().parallel_for, running inline when threads == 1
+void parallel_for(
+    uint32_t count,
+    uint32_t threads,
+    const std::function<void(uint32_t)>& fn
+);
+
+} // namespace wm
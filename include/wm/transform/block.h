@@ -15,4 +15,18 @@ void for_each_block_8x8(const SubbandView& band, Fn&& fn) {
     }
 }
 
+// Copy a strided 8×8 block into 64 contiguous floats
+inline void load_block_8x8(const float* base, uint32_t stride, float* block) {
+    for (uint32_t y = 0; y < 8; ++y)
+        for (uint32_t x = 0; x < 8; ++x)
+            block[y * 8 + x] = base[y * stride + x];
+}
+
+// Copy 64 contiguous floats back into a strided 8×8 block
+inline void store_block_8x8(const float* block, float* base, uint32_t stride) {
+    for (uint32_t y = 0; y < 8; ++y)
+        for (uint32_t x = 0; x < 8; ++x)
+            base[y * stride + x] = block[y * 8 + x];
+}
+
 } // namespace wm
@@ -3,10 +3,29 @@
 
 namespace wm {
 
-// In-place 8×8 DCT
+// Orthonormal 8×8 DCT-II / DCT-III on row-major blocks (input and output
+// may not alias).
+//
+// dct8x8 / idct8x8 use the factorized AAN flowgraph (5 multiplies per
+// 1-D pass, normalization folded into one 64-entry scale table). They agree
+// with the direct-form reference to within DCT_TOLERANCE per coefficient for
+// inputs in [-255, 255].
+
+// Max absolute deviation of the fast/separable kernels from the reference
+constexpr float DCT_TOLERANCE = 2e-3f;
+
+// Forward 8×8 DCT
 void dct8x8(const float* input, float* output);
 
-// In-place 8×8 inverse DCT
+// Inverse 8×8 DCT
 void idct8x8(const float* input, float* output);
 
+// Separable row/column DCT driven by the precomputed basis table
+void dct8x8_separable(const float* input, float* output);
+void idct8x8_separable(const float* input, float* output);
+
+// Direct O(n⁴) definition, kept as the accuracy reference
+void dct8x8_reference(const float* input, float* output);
+void idct8x8_reference(const float* input, float* output);
+
 } // namespace wm
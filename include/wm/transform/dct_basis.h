@@ -0,0 +1,59 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "wm/transform/dct_mask.h"
+
+namespace wm {
+
+// Upper bound on coefficients per mask (the full 8×8 block)
+constexpr uint32_t DCT_BASIS_MAX = 64;
+
+// Precomputed DCT basis data for a set of coefficients.
+//
+// vectors[i] is the 2-D basis image of coefficient i:
+//   vectors[i][x * 8 + y] = B[u_i][x] * B[v_i][y]
+// Analysis uses the factorized form: one 8-wide row combination per
+// distinct u (row_freq), then one 8-element dot product per coefficient.
+struct MaskBasis {
+    uint32_t count;
+    DCTIndex index[DCT_BASIS_MAX];
+    alignas(32) float vectors[DCT_BASIS_MAX][64];
+
+    uint32_t row_count;                 // distinct u values in the mask
+    uint8_t row_freq[8];                // those u values
+    uint8_t row_of[DCT_BASIS_MAX];      // coefficient i -> row_freq slot
+};
+
+// Build basis images for an arbitrary mask (count <= DCT_BASIS_MAX)
+void build_mask_basis(const DCTIndex* mask, uint32_t count, MaskBasis& out);
+
+// Basis for DCT_MID_FREQ_MASK, built once on first use
+const MaskBasis& mid_freq_basis();
+
+// Every ±1 combination of a mask's basis images:
+//   patterns[m * 64 + k] = sum_i s_i(m) * vectors[i][k]
+// with s_i(m) = +1 if bit i of m is set, else -1. Adding alpha · b times
+// one entry to a spatial block equals adding alpha · b · s_i to each masked
+// DCT coefficient, without a forward or inverse transform.
+constexpr uint32_t SIGN_PATTERN_MAX_BITS = 8;
+
+struct SignPatterns {
+    uint32_t count;              // mask size, <= SIGN_PATTERN_MAX_BITS
+    std::vector<float> patterns; // (1 << count) × 64
+};
+
+void build_sign_patterns(const MaskBasis& basis, SignPatterns& out);
+
+// Sign patterns for DCT_MID_FREQ_MASK, built once on first use
+const SignPatterns& mid_freq_sign_patterns();
+
+// Compute only the masked DCT coefficients of a strided 8×8 block.
+// coeff_out receives basis.count values in mask order.
+void analyze_masked(
+    const float* spatial_block,
+    uint32_t stride,
+    const MaskBasis& basis,
+    float* coeff_out
+);
+
+} // namespace wm
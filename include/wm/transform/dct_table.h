@@ -0,0 +1,52 @@
+#pragma once
+#include <cstdint>
+
+namespace wm {
+
+// Orthonormal 8-point DCT-II basis:
+//   DCT8_BASIS[k][x] = alpha(k) * cos((2x + 1) * k * pi / 16)
+// with alpha(0) = sqrt(1/8) and alpha(k > 0) = sqrt(2/8).
+constexpr float DCT8_BASIS[8][8] = {
+    { +0.353553391f, +0.353553391f, +0.353553391f, +0.353553391f, +0.353553391f, +0.353553391f, +0.353553391f, +0.353553391f },
+    { +0.490392640f, +0.415734806f, +0.277785117f, +0.097545161f, -0.097545161f, -0.277785117f, -0.415734806f, -0.490392640f },
+    { +0.461939766f, +0.191341716f, -0.191341716f, -0.461939766f, -0.461939766f, -0.191341716f, +0.191341716f, +0.461939766f },
+    { +0.415734806f, -0.097545161f, -0.490392640f, -0.277785117f, +0.277785117f, +0.490392640f, +0.097545161f, -0.415734806f },
+    { +0.353553391f, -0.353553391f, -0.353553391f, +0.353553391f, +0.353553391f, -0.353553391f, -0.353553391f, +0.353553391f },
+    { +0.277785117f, -0.490392640f, +0.097545161f, +0.415734806f, -0.415734806f, -0.097545161f, +0.490392640f, -0.277785117f },
+    { +0.191341716f, -0.461939766f, +0.461939766f, -0.191341716f, -0.191341716f, +0.461939766f, -0.461939766f, +0.191341716f },
+    { +0.097545161f, -0.277785117f, +0.415734806f, -0.490392640f, +0.490392640f, -0.415734806f, +0.277785117f, -0.097545161f },
+};
+
+// AAN (Arai–Agui–Nakajima) per-frequency scale: sqrt(2) * cos(k * pi / 16),
+// with the k = 0 term fixed to 1.
+constexpr float AAN_SCALE[8] = {
+    1.000000000f, 1.387039845f, 1.306562965f, 1.175875602f,
+    1.000000000f, 0.785694958f, 0.541196100f, 0.275899379f
+};
+
+struct DctScaleTable {
+    float v[64];
+};
+
+// Two unscaled AAN forward passes yield DCT[u][v] * 8 * s[u] * s[v]
+constexpr DctScaleTable make_aan_fdct_scale() {
+    DctScaleTable t{};
+    for (int u = 0; u < 8; ++u)
+        for (int v = 0; v < 8; ++v)
+            t.v[u * 8 + v] = 1.0f / (8.0f * AAN_SCALE[u] * AAN_SCALE[v]);
+    return t;
+}
+
+// Inverse AAN passes expect coefficients premultiplied by s[u] * s[v] / 8
+constexpr DctScaleTable make_aan_idct_scale() {
+    DctScaleTable t{};
+    for (int u = 0; u < 8; ++u)
+        for (int v = 0; v < 8; ++v)
+            t.v[u * 8 + v] = AAN_SCALE[u] * AAN_SCALE[v] / 8.0f;
+    return t;
+}
+
+inline constexpr DctScaleTable AAN_FDCT_SCALE = make_aan_fdct_scale();
+inline constexpr DctScaleTable AAN_IDCT_SCALE = make_aan_idct_scale();
+
+} // namespace wm
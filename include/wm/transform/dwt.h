@@ -1,4 +1,5 @@
 #pragma once
+#include <cstddef>
 #include <cstdint>
 
 namespace wm {
@@ -9,4 +10,40 @@ void dwt2_haar(float* data, uint32_t width, uint32_t height);
 // In-place inverse 2-level Haar DWT
 void idwt2_haar(float* data, uint32_t width, uint32_t height);
 
+// Scratch floats required by the workspace overloads below
+size_t dwt_scratch_size(uint32_t width, uint32_t height);
+
+// Same transforms with caller-provided scratch (dwt_scratch_size floats);
+// these perform no heap allocation
+void dwt2_haar(float* data, uint32_t width, uint32_t height, float* scratch);
+void idwt2_haar(float* data, uint32_t width, uint32_t height, float* scratch);
+
+// --------------------------------
+// 32×32 tiles
+// --------------------------------
+// With two levels, every 32×32 pixel tile maps onto one 8×8 block of each
+// level-2 subband. The tile transforms below run the same per-element
+// arithmetic as dwt2_haar/idwt2_haar, so a tile's subbands are bit-exact
+// copies of the matching region of the full-image transform.
+constexpr uint32_t DWT_TILE = 32;
+
+// Forward transform of the tile at `src` (row stride `stride`) into
+// `tile` (DWT_TILE² floats, same layout as dwt2_haar on a 32×32 image)
+void dwt2_haar_tile(const float* src, uint32_t stride, float* tile);
+
+// Inverse of dwt2_haar_tile; `tile` is used as scratch
+void idwt2_haar_tile(float* tile, float* dst, uint32_t stride);
+
+// Level-2 HL and LH subbands computed directly from each 4×4 pixel
+// neighbourhood, leaving the input untouched. hl and lh each receive
+// (width/4)×(height/4) floats, row-major with stride width/4, matching
+// HL2/LH2 of dwt2_haar up to float rounding.
+void haar_detail2(const float* data, uint32_t width, uint32_t height,
+                  float* hl, float* lh);
+
+// haar_detail2 of the tile at `src` (row stride `stride`): its 8×8 HL2
+// and LH2 blocks, each row-major with stride 8
+void haar_detail2_tile(const float* src, uint32_t stride,
+                       float* hl, float* lh);
+
 } // namespace wm
@@ -15,6 +15,21 @@ typedef struct {
     uint8_t* data;        // size = width * height * channels
 } WM_ImageBuffer;
 
+// Interleaved 8-bit pixels with an arbitrary row pitch
+typedef enum {
+    WM_PIXEL_RGB8 = 0,
+    WM_PIXEL_RGBA8 = 1,
+    WM_PIXEL_BGRA8 = 2
+} WM_PixelFormat;
+
+typedef struct {
+    uint32_t width;
+    uint32_t height;
+    uint32_t pitch;       // bytes per row, >= width * bytes per pixel
+    uint32_t format;      // WM_PixelFormat
+    uint8_t* data;
+} WM_PixelBuffer;
+
 // --------------------
 // Watermark payload
 // --------------------
@@ -26,15 +41,81 @@ typedef struct {
     uint64_t seed;
 } WM_Key;
 
+// --------------------
+// Embedding scheme
+// --------------------
+// Versioned building blocks of the embedding. Content must be extracted
+// with the scheme it was embedded with; zero-initialised means v1.
+typedef enum {
+    WM_PERMUTATION_V1_SHUFFLE = 0,   // keyed Fisher–Yates table
+    WM_PERMUTATION_V2_FEISTEL = 1    // random-access Feistel cipher
+} WM_PermutationScheme;
+
+typedef enum {
+    WM_PN_V1_PER_CHIP = 0,           // one hash per chip
+    WM_PN_V2_PACKED   = 1            // one hash per block, packed signs
+} WM_PnScheme;
+
+typedef struct {
+    uint32_t permutation;     // WM_PermutationScheme
+    uint32_t pn;              // WM_PnScheme
+} WM_Scheme;
+
+// --------------------
+// Pattern storage
+// --------------------
+typedef enum {
+    WM_PATTERN_FLOAT32 = 0,   // exact pattern, 4 bytes per pixel
+    WM_PATTERN_INT16   = 1    // quantized to the pattern's peak, 2 bytes
+} WM_PatternFormat;
+
+// --------------------
+// Thread count
+// --------------------
+// options->threads: 0 and 1 run on the calling thread, n uses up to n
+// threads (capped at the core count), WM_THREADS_ALL uses every core
+#define WM_THREADS_ALL 0xFFFFFFFFu
+
 // --------------------
 // Embedding options
 // --------------------
 typedef struct {
-    float strength_scale;     // default = 1.0
-    uint32_t redundancy;      // blocks per bit (default ~48)
+    float strength_scale;     // default = 1.0 (0 is treated as 1.0)
+    uint32_t redundancy;      // blocks per bit (default ~48, not yet used)
+    uint32_t threads;         // 0/1 = calling thread, WM_THREADS_ALL = all cores
+    WM_Scheme scheme;
 } WM_EmbedOptions;
 
+// --------------------
+// Extraction options
+// --------------------
+typedef enum {
+    WM_EXTRACT_TRANSFORM      = 0,  // DWT + masked DCT + PN correlation
+    WM_EXTRACT_MATCHED_FILTER = 1   // spatial templates, no transform
+} WM_ExtractMode;
+
+typedef struct {
+    uint32_t threads;         // 0/1 = calling thread, WM_THREADS_ALL = all cores
+    WM_Scheme scheme;         // must match the embedding
+    uint32_t mode;            // WM_ExtractMode
+} WM_ExtractOptions;
+
+// --------------------
+// Sequential verification
+// --------------------
+// Error bounds of the early-exit test (0 = default)
+typedef struct {
+    float false_accept;       // P(VERIFIED | unmarked), default 1e-6
+    float false_reject;       // P(TAMPERED | marked),   default 1e-3
+    float block_accuracy;     // P(block vote == bit | marked), default 0.75
+} WM_SequentialOptions;
 
+// --------------------
+// Presence pre-screen
+// --------------------
+typedef struct {
+    uint32_t blocks_per_bit;  // blocks sampled per bit, default 4 (0)
+} WM_PresenceOptions;
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,30 @@
+#pragma once
+#include <cstdint>
+
+namespace wm {
+
+// Marks a block that carries no payload bit (more blocks than
+// payload_len × blocks_per_bit)
+constexpr uint32_t NO_BIT = 0xFFFFFFFFu;
+
+// Watermark block geometry for a W×H luminance plane. Each 32×32 pixel
+// tile holds one 8×8 block of HL2 and one of LH2; blocks are numbered
+// HL2 first (row-major), then LH2.
+struct BlockLayout {
+    uint32_t blocks_x;
+    uint32_t blocks_y;
+    uint32_t blocks_per_band;
+    uint32_t total_blocks;
+    uint32_t blocks_per_bit;
+    uint32_t used_slots;      // blocks_per_bit × payload_len
+};
+
+// Fails if W or H is not a multiple of 32 or the payload does not fit
+bool make_block_layout(
+    uint32_t width,
+    uint32_t height,
+    uint32_t payload_len,
+    BlockLayout& out
+);
+
+} // namespace wm
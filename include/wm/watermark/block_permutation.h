@@ -10,4 +10,35 @@ void generate_block_permutation(
     uint32_t total_blocks
 );
 
+// Inverse permutation: slot_of_block[perm[s]] = s
+void invert_block_permutation(
+    const uint32_t* perm,
+    uint32_t* slot_of_block,
+    uint32_t total_blocks
+);
+
+// --------------------------------
+// Random-access permutation (v2)
+// --------------------------------
+// Keyed bijection on [0, n): a 4-round balanced Feistel network on the
+// smallest even bit width covering n, cycle-walked back into range.
+// Each lookup is O(1) on average (fewer than 4 walks) and needs no table.
+struct FeistelPermutation {
+    uint32_t n;
+    uint32_t half_bits;
+    uint64_t round_keys[4];
+};
+
+void make_feistel_permutation(
+    uint64_t key,
+    uint32_t n,
+    FeistelPermutation& out
+);
+
+// Block at position `index` (index < n)
+uint32_t feistel_permute(const FeistelPermutation& f, uint32_t index);
+
+// Position of `block` (block < n); inverse of feistel_permute
+uint32_t feistel_unpermute(const FeistelPermutation& f, uint32_t block);
+
 }
@@ -3,7 +3,10 @@
 
 namespace wm {
 
-// Embed a single watermark bit into one 8×8 block (in-place)
+// Embed a single watermark bit into one 8×8 block (in-place).
+// Adds the PN-signed combination of the masked DCT basis images directly
+// in the spatial domain; equivalent to embed_bit_block_transform up to
+// float rounding.
 void embed_bit_block(
     float* spatial_block,   // pointer to top-left of 8×8 block
     uint32_t stride,         // image stride
@@ -14,4 +17,37 @@ void embed_bit_block(
     float alpha              // embedding strength
 );
 
+// Add weight × (PN-signed basis pattern) to one 8×8 block, with the PN
+// chips given as a pn_mask sign mask. embed_bit_block is this with
+// weight = alpha·bit.
+void embed_mask_block(
+    float* spatial_block,
+    uint32_t stride,
+    float weight,
+    uint8_t pn_signs
+);
+
+// Transform-domain embedding: forward DCT, spread-spectrum step,
+// inverse DCT. Kept as the reference for embed_bit_block.
+void embed_bit_block_transform(
+    float* spatial_block,
+    uint32_t stride,
+    int8_t bit,
+    uint64_t key,
+    uint32_t bit_index,
+    uint32_t block_index,
+    float alpha
+);
+
+// Spread-spectrum step only: add alpha·bit·PN to the masked
+// coefficients of an already transformed block (64 floats, in-place)
+void embed_bit_coeffs(
+    float* coeff,
+    int8_t bit,
+    uint64_t key,
+    uint32_t bit_index,
+    uint32_t block_index,
+    float alpha
+);
+
 } // namespace wm
@@ -1,15 +1,55 @@
 #pragma once
 #include <cstdint>
 #include "wm/image.h"
+#include "wm/watermark/embed_tile.h"
+#include "wm/watermark/plan.h"
 
 namespace wm {
 
-// Embed a payload into an image (in-place luminance assumed)
+// Embed a payload into an image (in-place luminance assumed).
+// Works one 32×32 tile at a time (see embed_tile), so each pixel is read
+// and written once while the tile is still in cache. Rows of tiles are
+// split over `threads` threads (0 = all cores); tiles never overlap, so
+// the output does not depend on the thread count.
 bool embed_image(
     Image& img,
     const int8_t* payload_bits, // length = payload_len
     uint32_t payload_len,
     uint64_t key,
+    float alpha,
+    uint32_t threads = 1
+);
+
+// Same with a prebuilt plan (no per-call setup). The image must have the
+// plan's dimensions and payload_bits plan.payload_len entries.
+bool embed_image(
+    const Plan& plan,
+    Image& img,
+    const int8_t* payload_bits,
+    float alpha,
+    uint32_t threads = 1
+);
+
+// Several independent watermarks (see EmbedLayer) in one pass: each tile
+// makes a single Haar round trip however many layers there are, so the
+// cost is close to a single-layer embed. All plans must have the image's
+// dimensions. Matches embedding the layers one after another up to float
+// rounding (fewer round trips, so less of it).
+bool embed_image_layers(
+    Image& img,
+    const EmbedLayer* layers,
+    uint32_t count,
+    uint32_t threads = 1
+);
+
+// Pass-based embedding: full-image DWT, per-block embedding in
+// permutation order, full-image IDWT. Kept as the reference for
+// embed_image, which matches it bit for bit.
+bool embed_image_reference(
+    Image& img,
+    const int8_t* payload_bits,
+    uint32_t payload_len,
+    uint64_t key,
     float alpha
 );
 
@@ -0,0 +1,24 @@
+#pragma once
+#include <cstdint>
+#include "wm/image.h"
+#include "wm/watermark/plan.h"
+
+namespace wm {
+
+// Embed into the BT.601 luminance of an interleaved 8-bit image, in
+// place. Each 32×32 tile is converted to Y (luma_row), embedded with
+// embed_tile, and the change in Y is added back to its R, G and B with
+// rounding and saturation (add_luma_row). Only two tile-sized float
+// buffers are used, so no float copy of the image is ever made. The Y
+// tile gets exactly what embed_image would do to the matching region of
+// the full luminance plane. Tile rows are split over `threads` threads
+// (0 = all cores) without changing the result.
+bool embed_pixels(
+    const Plan& plan,
+    PixelImage& img,
+    const int8_t* payload_bits,
+    float alpha,
+    uint32_t threads = 1
+);
+
+} // namespace wm
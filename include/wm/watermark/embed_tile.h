@@ -0,0 +1,77 @@
+#pragma once
+#include <cstdint>
+#include "wm/watermark/plan.h"
+
+namespace wm {
+
+// What one level-2 block of a tile carries
+struct TileBlock {
+    uint32_t bit_index;     // payload bit, or NO_BIT
+    int8_t bit;             // +1 or -1 (ignored for NO_BIT)
+    uint8_t pn_signs;       // pn_mask of (bit_index, block)
+};
+
+// The HL2 and LH2 blocks of tile (bx, by) under `plan`
+void tile_blocks(
+    const Plan& plan,
+    const int8_t* payload_bits,
+    uint32_t bx,
+    uint32_t by,
+    TileBlock out[2]
+);
+
+// Fused embed of one 32×32 pixel tile (in-place): local 2-level Haar
+// analysis, embedding into its HL2 block (blocks[0]) and LH2 block
+// (blocks[1]), synthesis and write-back. Bit-identical to running the
+// same blocks through dwt2_haar → embed_bit_block → idwt2_haar.
+void embed_tile(
+    float* pixels,          // top-left of the tile
+    uint32_t stride,        // image stride
+    const TileBlock blocks[2],
+    float alpha
+);
+
+// One independent watermark of a multi-layer embed
+struct EmbedLayer {
+    const Plan* plan;
+    const int8_t* payload_bits;     // plan->payload_len entries
+    float alpha;
+};
+
+// Several layers in one round trip: blocks[2 * l] and blocks[2 * l + 1]
+// are the HL2/LH2 blocks of layers[l], embedded with layers[l].alpha.
+// Embedding is additive in the detail blocks, so this matches embedding
+// the layers one after another up to the float rounding of the extra
+// round trips.
+void embed_tile(
+    float* pixels,
+    uint32_t stride,
+    const TileBlock* blocks,    // 2 × count
+    const EmbedLayer* layers,
+    uint32_t count
+);
+
+// Embed every tile of tile row `by`. `band` points to the first of its
+// 32 pixel rows.
+void embed_tile_row(
+    float* band,
+    uint32_t stride,
+    uint32_t by,
+    const Plan& plan,
+    const int8_t* payload_bits,
+    float alpha
+);
+
+// embed_tile_row for several layers, one round trip per tile. All plans
+// must have the same dimensions. `blocks` is caller-owned scratch for
+// 2 × count TileBlocks, so the row itself never allocates.
+void embed_tile_row(
+    float* band,
+    uint32_t stride,
+    uint32_t by,
+    const EmbedLayer* layers,
+    uint32_t count,
+    TileBlock* blocks
+);
+
+} // namespace wm
@@ -13,4 +13,20 @@ int8_t extract_bit_block(
     uint32_t block_index         // block id (spatial index)
 );
 
+// Correlation detector only: sum of masked coefficients times PN.
+// masked_coeff holds DCT_MASK_SIZE values in DCT_MID_FREQ_MASK order,
+// as produced by analyze_masked.
+float correlate_bit_coeffs(
+    const float* masked_coeff,
+    uint64_t key,
+    uint32_t bit_index,
+    uint32_t block_index
+);
+
+// Same correlation with the PN chips given as a pn_mask sign mask
+float correlate_mask_coeffs(
+    const float* masked_coeff,
+    uint8_t pn_signs
+);
+
 } // namespace wm
@@ -1,16 +1,92 @@
 #pragma once
 #include <cstdint>
 #include "wm/image.h"
+#include "wm/watermark/plan.h"
 
 namespace wm {
 
-// Extract payload and per-bit confidence from image
+// How block correlations are computed
+enum class ExtractMode : uint8_t {
+    // Detail subbands, masked DCT analysis, PN correlation
+    Transform = 0,
+
+    // Dot product of each tile with the spatial templates of its blocks
+    // (see TileTemplates): one pass over the pixels, no transform. Agrees
+    // with Transform up to float rounding, so only blocks whose
+    // correlation is within rounding of zero may vote differently.
+    MatchedFilter = 1
+};
+
+// Extract payload and per-bit confidence from image.
+// The image is read only and never transformed in place. Blocks are
+// visited in memory order, one 32-row band per task, and their votes are
+// routed to bits through the plan's inverse permutation; bands are split
+// over `threads` threads (0 = all cores) without changing the result.
 bool extract_image(
-    Image& img,
+    const Image& img,
     int8_t* bits_out,         // length = payload_len
     float* confidence_out,    // length = payload_len
     uint32_t payload_len,
-    uint64_t key
+    uint64_t key,
+    uint32_t threads = 1
+);
+
+// Same with a prebuilt plan (no per-call setup). The image must have the
+// plan's dimensions; outputs hold plan.payload_len entries.
+bool extract_image(
+    const Plan& plan,
+    const Image& img,
+    int8_t* bits_out,
+    float* confidence_out,
+    uint32_t threads = 1,
+    ExtractMode mode = ExtractMode::Transform
+);
+
+// Hard decisions from block correlations: each block votes sign(c) for
+// its bit, confidence = |vote sum| / blocks_per_bit
+void votes_to_bits(
+    const Plan& plan,
+    const float* corr,          // block_correlations output
+    int8_t* bits_out,           // plan.payload_len
+    float* confidence_out       // plan.payload_len
+);
+
+// --------------------------------
+// Soft decisions
+// --------------------------------
+// A ±1 vote per block counts a block that barely correlates the same as a
+// strong one. The soft score of a bit combines the raw correlations c_k
+// of its blocks instead:
+//   z = sum(c_k) / sqrt(sum(c_k²))
+// Without a watermark the c_k are zero-mean with random signs, so z is
+// close to N(0, 1) whatever the image contrast; a watermark shifts it by
+// about sqrt(blocks_per_bit) times the per-block SNR.
+void soft_scores(
+    const Plan& plan,
+    const float* corr,          // block_correlations output
+    float* score_out            // plan.payload_len
+);
+
+// Soft-decision extraction: bits_out = sign(z) and confidence_out =
+// erf(|z| / sqrt 2), the chance that an unmarked bit scores below |z|.
+bool extract_image_soft(
+    const Plan& plan,
+    const Image& img,
+    int8_t* bits_out,
+    float* confidence_out,
+    float* score_out,
+    uint32_t threads = 1,
+    ExtractMode mode = ExtractMode::Transform
+);
+
+// Soft PN correlation of every block, indexed by block (0 for blocks that
+// carry no bit). extract_image votes with their signs.
+bool block_correlations(
+    const Plan& plan,
+    const Image& img,
+    float* corr_out,            // plan.layout.total_blocks
+    ExtractMode mode,
+    uint32_t threads = 1
 );
 
 }
@@ -0,0 +1,40 @@
+#pragma once
+#include <cstdint>
+
+#include "wm/watermark/plan.h"
+#include "wm/watermark/tile_templates.h"
+
+namespace wm {
+
+// --------------------------------
+// Fan-out synthesis
+// --------------------------------
+// An embedded tile is
+//   source + alpha · (b_HL · T[HL][m_HL] + b_LH · T[LH][m_LH])
+// with T the tile templates, so any number of payloads can be embedded
+// into one source without a transform per output.
+
+// dst = source with payload_bits embedded at `alpha`, for tile row `by`.
+// src_band/dst_band point to the first of its 32 rows; both have row
+// stride `stride`. Matches embed_image up to float rounding.
+void fanout_tile_row(
+    const float* src_band,
+    float* dst_band,
+    uint32_t stride,
+    uint32_t by,
+    const Plan& plan,
+    const int8_t* payload_bits,
+    float alpha
+);
+
+// Whole plane, tile rows split over `threads` threads (0 = all cores)
+void fanout_embed(
+    const Plan& plan,
+    const float* source,
+    const int8_t* payload_bits,
+    float alpha,
+    float* dst,
+    uint32_t threads = 1
+);
+
+} // namespace wm
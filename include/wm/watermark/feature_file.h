@@ -0,0 +1,75 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace wm {
+
+// --------------------------------
+// Feature files
+// --------------------------------
+// On-disk form of compute_features output, laid out so a mapped file can
+// be used in place:
+//
+//   offset 0   FeatureFileHeader (64 bytes)
+//   offset 64  features, float32, block-major as in features.h
+//
+// Integers and floats are in the writer's byte order; byte_order lets a
+// reader reject a file from a host of the other order instead of
+// misreading it. The data starts 64-byte aligned in a mapped file.
+// Anything that changes the features (transform, mask, block numbering)
+// must bump FEATURE_FILE_VERSION.
+constexpr uint32_t FEATURE_FILE_VERSION = 1;
+constexpr uint32_t FEATURE_FILE_BYTE_ORDER = 0x01020304u;
+constexpr char FEATURE_FILE_MAGIC[8] = { 'W', 'M', 'F', 'E', 'A', 'T', 0, 0 };
+
+struct FeatureFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t header_size;       // offset of the features
+    uint32_t width;
+    uint32_t height;
+    uint32_t block_count;
+    uint32_t coeffs_per_block;  // DCT_MASK_SIZE
+    uint32_t reserved[7];       // zero
+};
+
+static_assert(sizeof(FeatureFileHeader) == 64,
+              "feature file header is 64 bytes");
+
+// Header plus features of a width × height image
+size_t feature_file_size(uint32_t width, uint32_t height);
+
+// Header for a width × height image (multiples of 32)
+FeatureFileHeader make_feature_header(uint32_t width, uint32_t height);
+
+// Validates a file image of `size` bytes. On success `features` points
+// into `data` (no copy) and width/height are set. Fails on a wrong magic,
+// version, byte order or coefficient count, or a size that does not
+// match the header.
+bool parse_feature_file(
+    const void* data,
+    size_t size,
+    uint32_t& width,
+    uint32_t& height,
+    const float*& features
+);
+
+// --------------------------------
+// File helpers
+// --------------------------------
+// Whole-file write; false on any I/O error
+bool write_file(const char* path, const void* data, size_t size);
+
+// Read-only mapping of a whole file (mmap where available, otherwise a
+// heap copy). Release with unmap_file.
+struct MappedFile {
+    const void* data = nullptr;
+    size_t size = 0;
+    bool mapped = false;        // true: mmap, false: heap copy
+};
+
+bool map_file(const char* path, MappedFile& out);
+void unmap_file(MappedFile& file);
+
+} // namespace wm
@@ -0,0 +1,46 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#include "wm/image.h"
+#include "wm/watermark/plan.h"
+
+namespace wm {
+
+// --------------------------------
+// Mid-frequency features
+// --------------------------------
+// The only image-dependent input to extraction is the DCT_MID_FREQ_MASK
+// coefficients of each HL2/LH2 block. They do not depend on the key, so
+// they can be computed once and checked against any number of plans of
+// the same dimensions. features[p * DCT_MASK_SIZE + i] is coefficient i
+// of block p, numbered as in BlockLayout (HL2 first, then LH2).
+
+// Floats needed for a width × height image (both multiples of 32)
+size_t feature_count(uint32_t width, uint32_t height);
+
+// Fails if width or height is not a multiple of 32. Tile rows are split
+// over `threads` threads (0 = all cores) without changing the result.
+bool compute_features(
+    const Image& img,
+    float* features_out,        // feature_count(img.width, img.height)
+    uint32_t threads = 1
+);
+
+// PN correlation of every block from its features (0 for blocks that
+// carry no bit); bit-exact with block_correlations in Transform mode
+void feature_correlations(
+    const Plan& plan,
+    const float* features,
+    float* corr_out             // plan.layout.total_blocks
+);
+
+// extract_image from features: identical bits and confidences
+void extract_features(
+    const Plan& plan,
+    const float* features,
+    int8_t* bits_out,
+    float* confidence_out
+);
+
+} // namespace wm
@@ -0,0 +1,47 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "wm/image.h"
+#include "wm/watermark/plan.h"
+
+namespace wm {
+
+// Storage of a cached pattern plane
+enum class PatternFormat : uint8_t {
+    Float32 = 0,
+    Int16   = 1     // value = q * scale, scale = max|P| / 32767
+};
+
+// The signal embed_image adds for one (plan, payload, alpha). The Haar
+// and DCT stages are linear and the embedding adds a fixed pattern per
+// block, so embed_image(Y) = Y + P with P independent of the pixels. A
+// Pattern holds P for the whole plane; applying it is one streaming add,
+// with no transform. Results match embed_image up to float rounding
+// (plus half a quantization step for Int16).
+struct Pattern {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    PatternFormat format = PatternFormat::Float32;
+    float scale = 0.0f;             // Int16 only
+
+    std::vector<float> f32;         // Float32: width × height
+    std::vector<int16_t> i16;       // Int16:   width × height
+};
+
+// Compute P by embedding into an all-zero plane of the plan's size.
+// payload_bits holds plan.payload_len entries.
+bool build_pattern(
+    Pattern& out,
+    const Plan& plan,
+    const int8_t* payload_bits,
+    float alpha,
+    PatternFormat format,
+    uint32_t threads = 1
+);
+
+// img.Y += P. Rows are split over `threads` threads (0 = all cores); the
+// image must have the pattern's dimensions.
+bool apply_pattern(const Pattern& pattern, Image& img, uint32_t threads = 1);
+
+} // namespace wm
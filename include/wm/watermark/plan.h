@@ -0,0 +1,76 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "wm/watermark/block_layout.h"
+#include "wm/watermark/block_permutation.h"
+#include "wm/watermark/pn.h"
+#include "wm/watermark/scheme.h"
+
+namespace wm {
+
+// Everything about block placement that depends only on
+// (key, width, height, payload_len): the key permutation, which payload
+// bit each block carries and its PN signs. Built once, then read-only, so
+// one plan can serve any number of embed/extract calls on any number of
+// threads.
+//
+// With the Feistel permutation the tables are optional: a plan built
+// without them answers the plan_* lookups below in O(1) from the cipher,
+// so its size no longer depends on the image.
+struct Plan {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t payload_len = 0;
+    uint64_t key = 0;
+
+    Scheme scheme{};
+    BlockLayout layout{};
+    FeistelPermutation feistel{};         // Feistel scheme only
+
+    std::vector<uint32_t> block_of_slot;  // key permutation
+    std::vector<uint32_t> bit_of_block;   // payload bit carried, or NO_BIT
+    std::vector<uint8_t> pn_signs;        // PN sign mask of each block; 0 for NO_BIT
+};
+
+// Fails under the same conditions as make_block_layout. `tables` may only
+// be false for the Feistel scheme.
+bool build_plan(
+    Plan& plan,
+    uint32_t width,
+    uint32_t height,
+    uint32_t payload_len,
+    uint64_t key,
+    const Scheme& scheme = Scheme{},
+    bool tables = true
+);
+
+// --------------------------------
+// Lookups that work with or without tables
+// --------------------------------
+inline uint32_t plan_block_of_slot(const Plan& plan, uint32_t slot) {
+    if (!plan.block_of_slot.empty())
+        return plan.block_of_slot[slot];
+    return feistel_permute(plan.feistel, slot);
+}
+
+inline uint32_t plan_bit_of_block(const Plan& plan, uint32_t block) {
+    if (!plan.bit_of_block.empty())
+        return plan.bit_of_block[block];
+
+    uint32_t slot = feistel_unpermute(plan.feistel, block);
+    return slot < plan.layout.used_slots
+               ? slot / plan.layout.blocks_per_bit
+               : NO_BIT;
+}
+
+// PN signs of `block`, which carries payload bit `bit` (not NO_BIT)
+inline uint8_t plan_pn_signs(const Plan& plan, uint32_t block, uint32_t bit) {
+    if (!plan.pn_signs.empty())
+        return plan.pn_signs[block];
+    return plan.scheme.pn == PnScheme::Packed
+               ? pn_mask_v2(plan.key, bit, block)
+               : pn_mask(plan.key, bit, block);
+}
+
+} // namespace wm
@@ -9,4 +9,38 @@ int8_t pn_chip(uint64_t key,
                uint32_t block_index,
                uint32_t chip_index);
 
+// All DCT_MASK_SIZE chips of one (bit, block) pair packed as signs:
+// bit i is set when chip i is +1
+uint8_t pn_mask(uint64_t key,
+                uint32_t bit_index,
+                uint32_t block_index);
+
+// pn_mask for blocks first_block .. first_block + count - 1, block i
+// carrying bit_index[i]. Hashes 4 blocks per AVX2 register when the host
+// supports it; results equal the scalar function.
+void pn_masks(uint64_t key,
+              const uint32_t* bit_index,
+              uint32_t first_block,
+              uint32_t count,
+              uint8_t* masks_out);
+
+// --------------------------------
+// v2: one hash per (bit, block)
+// --------------------------------
+// All chips come from a single SplitMix64 of (key, bit, block): chip i is
+// +1 when bit i of the hash is set. Returned in the same packed form as
+// pn_mask; the two schemes produce unrelated sequences.
+uint8_t pn_mask_v2(uint64_t key,
+                   uint32_t bit_index,
+                   uint32_t block_index);
+
+// pn_mask_v2 for blocks first_block .. first_block + count - 1, block i
+// carrying bit_index[i]. Uses 4 SplitMix lanes per AVX2 register when the
+// host supports it; results equal the scalar function.
+void pn_masks_v2(uint64_t key,
+                 const uint32_t* bit_index,
+                 uint32_t first_block,
+                 uint32_t count,
+                 uint8_t* masks_out);
+
 } // namespace wm
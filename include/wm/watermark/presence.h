@@ -0,0 +1,44 @@
+#pragma once
+#include <cstdint>
+
+#include "wm/image.h"
+#include "wm/watermark/plan.h"
+
+namespace wm {
+
+// --------------------------------
+// Presence pre-screen
+// --------------------------------
+// Answers "does this image carry the key's watermark at all?" from a
+// key-derived sample: the first `blocks_per_bit` slots of every bit, each
+// read from its own 32×32 tile (see block_correlation). For bit b with
+// sampled correlations c_i,
+//   z_b = Σ c_i / √Σ c_i²
+// and the global statistic is T = Σ_b z_b². Without the watermark the PN
+// signs make each z_b sub-Gaussian with unit variance proxy whatever the
+// image content, so T is dominated by χ² with n = payload_len degrees of
+// freedom and
+//   P(T ≥ t | unmarked) ≤ (t/n · e^(1 - t/n))^(n/2),   t > n
+// (Chernoff). A marked image drives T towards blocks_per_bit · n.
+struct PresenceParams {
+    uint32_t blocks_per_bit = 4;
+};
+
+struct PresenceOutcome {
+    float score = 0.0f;                 // (T - n) / √(2n), ≈ N(0,1) unmarked
+    float false_positive_bound = 1.0f;  // bound on P(T ≥ observed | unmarked)
+    uint32_t blocks_read = 0;
+};
+
+// Runs on the calling thread; blocks_per_bit is capped at the plan's.
+bool detect_presence(
+    const Plan& plan,
+    const Image& img,
+    const PresenceParams& params,
+    PresenceOutcome& outcome
+);
+
+// Chernoff bound on the upper tail of χ² with n degrees of freedom
+double chi2_tail_bound(double t, uint32_t n);
+
+} // namespace wm
@@ -0,0 +1,27 @@
+#pragma once
+#include <cstdint>
+
+namespace wm {
+
+// Versioned building blocks of the embedding. Content must be extracted
+// with the scheme it was embedded with; the defaults are the original v1
+// scheme. Values match the WM_* constants of the C ABI.
+
+// How payload slots are assigned to blocks
+enum class PermutationScheme : uint8_t {
+    Shuffle = 0,   // v1: keyed Fisher–Yates table
+    Feistel = 1    // v2: random-access Feistel cipher, no table
+};
+
+// How PN chips are derived for a (bit, block) pair
+enum class PnScheme : uint8_t {
+    PerChip = 0,   // v1: one SplitMix64 per chip (pn_mask)
+    Packed = 1     // v2: one SplitMix64 per block (pn_mask_v2)
+};
+
+struct Scheme {
+    PermutationScheme permutation = PermutationScheme::Shuffle;
+    PnScheme pn = PnScheme::PerChip;
+};
+
+} // namespace wm
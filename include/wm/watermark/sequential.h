@@ -0,0 +1,58 @@
+#pragma once
+#include <cstdint>
+
+#include "wm/image.h"
+#include "wm/watermark/plan.h"
+
+namespace wm {
+
+// --------------------------------
+// Sequential (SPRT) verification
+// --------------------------------
+// Blocks are read round by round: round k visits the k-th block of every
+// bit, so the order follows the key permutation and evidence grows evenly
+// across bits. After each round Wald's sequential probability ratio test
+// compares
+//   H1: marked, each block votes for its bit with probability p
+//   H0: unmarked, each vote is a fair coin
+// Bits are unknown, so a bit with a votes for +1 and d for -1 contributes
+//   LLR = log(½·(2p)^a·(2q)^d + ½·(2q)^a·(2p)^d),   q = 1 - p
+// and the test stops at
+//   Verified: sum LLR >= log((1 - β) / α) and every bit's sign has
+//             posterior error <= β, i.e. |a - d|·log(p/q) >= log((1-β)/β)
+//   Tampered: sum LLR <= log(β / (1 - α))
+// where α is the false-accept and β the false-reject rate.
+struct SequentialParams {
+    float false_accept = 1e-6f;     // α
+    float false_reject = 1e-3f;     // β
+    float block_accuracy = 0.75f;   // p
+};
+
+enum class SequentialVerdict : uint8_t {
+    Verified = 0,
+    Tampered,
+    Undecided       // every block read without reaching a bound
+};
+
+struct SequentialOutcome {
+    SequentialVerdict verdict = SequentialVerdict::Undecided;
+    uint32_t blocks_read = 0;
+    uint32_t rounds = 0;
+};
+
+// Runs on the calling thread, reading one 32×32 tile per visited block.
+// bits_out/confidence_out (plan.payload_len each) describe the votes read
+// so far: confidence = |vote sum| / votes read for that bit.
+bool extract_sequential(
+    const Plan& plan,
+    const Image& img,
+    const SequentialParams& params,
+    int8_t* bits_out,
+    float* confidence_out,
+    SequentialOutcome& outcome
+);
+
+// Transform-domain PN correlation of one block, from its tile only
+float block_correlation(const Plan& plan, const Image& img, uint32_t block);
+
+} // namespace wm
@@ -0,0 +1,83 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "wm/watermark/plan.h"
+
+namespace wm {
+
+// Rows per streamed band: one row of 32×32 tiles
+constexpr uint32_t STREAM_BAND_ROWS = 32;
+
+// --------------------------------
+// Streaming embed
+// --------------------------------
+// Bands of STREAM_BAND_ROWS × width floats (row stride = width) are pushed
+// top to bottom and embedded in place. The result is bit-identical to
+// embed_image on the whole plane. State is the plan and a copy of the
+// payload; pixel memory never exceeds one band, which the caller owns.
+// With the v1 shuffle the plan keeps only bit_of_block (4 bytes per
+// block, so it still grows with height); with the Feistel permutation it
+// holds no tables at all. Stream plans answer plan_bit_of_block and
+// plan_pn_signs only.
+struct EmbedStream {
+    Plan plan;
+    uint32_t next_band = 0;
+
+    std::vector<int8_t> payload;
+    float alpha = 0.0f;
+};
+
+bool embed_stream_begin(
+    EmbedStream& s,
+    uint32_t width,
+    uint32_t height,
+    const int8_t* payload_bits,
+    uint32_t payload_len,
+    uint64_t key,
+    float alpha,
+    const Scheme& scheme = Scheme{}
+);
+
+// Embed the next band (in-place). Fails once all bands have been pushed.
+bool embed_stream_push(EmbedStream& s, float* band);
+
+// Whether every band of the image has been pushed
+bool embed_stream_complete(const EmbedStream& s);
+
+// --------------------------------
+// Streaming extraction
+// --------------------------------
+// Bands are read only; per-bit votes accumulate as they arrive, and
+// extract_stream_finish produces the same bits and confidences as
+// extract_image on the whole plane. Scratch is width·STREAM_BAND_ROWS/8
+// floats of detail coefficients.
+struct ExtractStream {
+    Plan plan;
+    uint32_t next_band = 0;
+
+    std::vector<int32_t> votes;    // per payload bit
+    std::vector<float> detail;     // HL2 then LH2 rows of one band
+};
+
+bool extract_stream_begin(
+    ExtractStream& s,
+    uint32_t width,
+    uint32_t height,
+    uint32_t payload_len,
+    uint64_t key,
+    const Scheme& scheme = Scheme{}
+);
+
+// Accumulate evidence from the next band. Fails once all bands have been
+// pushed.
+bool extract_stream_push(ExtractStream& s, const float* band);
+
+// Fails unless every band has been pushed
+bool extract_stream_finish(
+    const ExtractStream& s,
+    int8_t* bits_out,         // length = payload_len
+    float* confidence_out     // length = payload_len
+);
+
+} // namespace wm
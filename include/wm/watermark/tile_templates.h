@@ -0,0 +1,46 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "wm/transform/dwt.h"
+
+namespace wm {
+
+// --------------------------------
+// Spatial tile templates
+// --------------------------------
+// Embedding adds weight × (sign pattern m) to a tile's HL2 or LH2 block and
+// transforms back. By linearity the pixel change is weight × a fixed 32×32
+// template that depends only on the subband and m, not on the tile or the
+// image. A payload bit's spatial template is the sum of these over its
+// blocks.
+//
+// The Haar and DCT stages are orthonormal, so the same template is also
+// the matched filter of the block: its PN correlation (masked DCT
+// coefficients of the level-2 block times the PN signs) equals the dot
+// product of the tile's pixels with T[band][m].
+struct TileTemplates {
+    uint32_t mask_count;        // 1 << DCT_MASK_SIZE
+    std::vector<float> data;    // 2 × mask_count × DWT_TILE²
+
+    const float* at(uint32_t band, uint8_t mask) const {
+        return data.data() +
+               (size_t(band) * mask_count + mask) * DWT_TILE * DWT_TILE;
+    }
+};
+
+// Templates for DCT_MID_FREQ_MASK, built once on first use
+const TileTemplates& mid_freq_tile_templates();
+
+// Dot products of one 32×32 pixel tile with two templates, in a single
+// pass over the pixels (8 partial sums per template, vectorizable)
+void correlate_tile(
+    const float* pixels,        // top-left of the tile
+    uint32_t stride,            // image stride
+    const float* tmpl0,
+    const float* tmpl1,
+    float* corr0,
+    float* corr1
+);
+
+} // namespace wm
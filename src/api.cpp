@@ -1,10 +1,57 @@
 #include "wm/api.h"
 
 #include "wm/image.h"
+#include "wm/thread_pool.h"
 #include "wm/watermark/embed_image.h"
+#include "wm/watermark/embed_pixels.h"
 #include "wm/watermark/extract_image.h"
+#include "wm/watermark/fanout.h"
+#include "wm/watermark/feature_file.h"
+#include "wm/watermark/features.h"
+#include "wm/watermark/pattern.h"
+#include "wm/watermark/presence.h"
+#include "wm/watermark/sequential.h"
+#include "wm/watermark/stream.h"
 
+#include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <new>
+#include <vector>
+
+static_assert(WM_STREAM_BAND_ROWS == wm::STREAM_BAND_ROWS,
+              "C and C++ band heights must agree");
+
+// Opaque handles
+struct WM_Context {
+    wm::Plan plan;
+};
+
+struct WM_Features {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    const float* data = nullptr;        // into bytes
+
+    const void* bytes = nullptr;        // file image
+    size_t size = 0;
+
+    std::vector<float> owned;           // computed: header + features
+    wm::MappedFile file;                // mapped
+
+    ~WM_Features() { wm::unmap_file(file); }
+};
+
+struct WM_Pattern {
+    wm::Pattern pattern;
+};
+
+struct WM_EmbedStream {
+    wm::EmbedStream s;
+};
+
+struct WM_ExtractStream {
+    wm::ExtractStream s;
+};
 
 extern "C" {
 
@@ -29,6 +76,116 @@ static WM_Verdict compute_verdict(
     return WM_VERDICT_UNVERIFIABLE;
 }
 
+// ----------------------------
+// Internal aggregation of per-bit confidences
+// ----------------------------
+static void aggregate_result(WM_ExtractResult* result) {
+    float sum = 0.0f;
+    float min_conf = 1.0f;
+    uint32_t weak = 0;
+
+    for (uint32_t i = 0; i < result->length; ++i) {
+        float c = result->confidence[i];
+        sum += c;
+        if (c < min_conf) min_conf = c;
+        if (c < 0.6f) weak++;
+    }
+
+    result->mean_confidence = sum / result->length;
+    result->min_confidence  = min_conf;
+    result->verdict = compute_verdict(
+        result->mean_confidence,
+        result->min_confidence,
+        weak,
+        result->length
+    );
+}
+
+// ----------------------------
+// Internal soft-decision statistics
+// ----------------------------
+static void aggregate_soft(WM_ExtractResultSoft* result, const float* z) {
+    aggregate_result(&result->base);
+
+    const uint32_t n = result->base.length;
+    float sum_abs = 0.0f;
+    float min_abs = INFINITY;
+    double sum_sq = 0.0;
+
+    for (uint32_t i = 0; i < n; ++i) {
+        float a = std::fabs(z[i]);
+        sum_abs += a;
+        if (a < min_abs) min_abs = a;
+        sum_sq += double(z[i]) * z[i];
+    }
+
+    result->mean_abs_score = sum_abs / n;
+    result->min_abs_score  = min_abs;
+    result->detection_z    = float((sum_sq - n) / std::sqrt(2.0 * n));
+}
+
+// ----------------------------
+// Scheme selection (NULL = v1)
+// ----------------------------
+static bool to_scheme(const WM_Scheme* in, wm::Scheme& out) {
+    out = wm::Scheme{};
+    if (!in)
+        return true;
+
+    switch (in->permutation) {
+        case WM_PERMUTATION_V1_SHUFFLE:
+            out.permutation = wm::PermutationScheme::Shuffle;
+            break;
+        case WM_PERMUTATION_V2_FEISTEL:
+            out.permutation = wm::PermutationScheme::Feistel;
+            break;
+        default:
+            return false;
+    }
+
+    switch (in->pn) {
+        case WM_PN_V1_PER_CHIP:
+            out.pn = wm::PnScheme::PerChip;
+            break;
+        case WM_PN_V2_PACKED:
+            out.pn = wm::PnScheme::Packed;
+            break;
+        default:
+            return false;
+    }
+
+    return true;
+}
+
+// ----------------------------
+// Thread count (NULL options / 0 = calling thread)
+// ----------------------------
+// Fanning out is opt-in: the internal pool treats 0 as all cores
+static uint32_t to_threads(uint32_t requested) {
+    if (requested == WM_THREADS_ALL)
+        return 0;
+    return requested == 0 ? 1 : requested;
+}
+
+// ----------------------------
+// Extraction mode (NULL options = transform)
+// ----------------------------
+static bool to_mode(const WM_ExtractOptions* options, wm::ExtractMode& out) {
+    out = wm::ExtractMode::Transform;
+    if (!options)
+        return true;
+
+    switch (options->mode) {
+        case WM_EXTRACT_TRANSFORM:
+            return true;
+        case WM_EXTRACT_MATCHED_FILTER:
+            out = wm::ExtractMode::MatchedFilter;
+            return true;
+        default:
+            return false;
+    }
+}
+
 // ----------------------------
 // wm_embed
 // ----------------------------
@@ -37,6 +194,16 @@ WM_Status wm_embed(
     const WM_Payload* payload,
     uint64_t key,
     float alpha
+) {
+    return wm_embed_ex(image, payload, key, alpha, nullptr);
+}
+
+WM_Status wm_embed_ex(
+    WM_Image* image,
+    const WM_Payload* payload,
+    uint64_t key,
+    float alpha,
+    const WM_EmbedOptions* options
 ) {
     if (!image || !payload || !payload->bits)
         return WM_ERR_INVALID_ARGUMENT;
@@ -49,24 +216,47 @@ WM_Status wm_embed(
     img.height = image->height;
     img.Y      = image->y;
 
-    bool ok = wm::embed_image(
-        img,
-        payload->bits,
-        payload->length,
-        key,
-        alpha
-    );
+    uint32_t threads = 1;
+    if (options) {
+        if (options->strength_scale > 0.0f)
+            alpha *= options->strength_scale;
+        threads = to_threads(options->threads);
+    }
 
-    return ok ? WM_OK : WM_ERR_INVALID_DIMENSIONS;
+    wm::Scheme scheme;
+    if (!to_scheme(options ? &options->scheme : nullptr, scheme))
+        return WM_ERR_INVALID_ARGUMENT;
+
+    try {
+        wm::Plan plan;
+        if (!wm::build_plan(plan, img.width, img.height, payload->length, key,
+                            scheme))
+            return WM_ERR_INVALID_DIMENSIONS;
+
+        bool ok = wm::embed_image(plan, img, payload->bits, alpha, threads);
+
+        return ok ? WM_OK : WM_ERR_INVALID_DIMENSIONS;
+    } catch (const std::bad_alloc&) {
+        return WM_ERR_INTERNAL;
+    }
 }
 
 // ----------------------------
 // wm_extract
 // ----------------------------
 WM_Status wm_extract(
-    WM_Image* image,
+    const WM_Image* image,
     uint64_t key,
     WM_ExtractResult* result
+) {
+    return wm_extract_ex(image, key, result, nullptr);
+}
+
+WM_Status wm_extract_ex(
+    const WM_Image* image,
+    uint64_t key,
+    WM_ExtractResult* result,
+    const WM_ExtractOptions* options
 ) {
     if (!image || !result || !result->bits || !result->confidence)
         return WM_ERR_INVALID_ARGUMENT;
@@ -79,41 +269,1326 @@ WM_Status wm_extract(
     img.height = image->height;
     img.Y      = image->y;
 
-    bool ok = wm::extract_image(
+    wm::Scheme scheme;
+    if (!to_scheme(options ? &options->scheme : nullptr, scheme))
+        return WM_ERR_INVALID_ARGUMENT;
+
+    wm::ExtractMode mode;
+    if (!to_mode(options, mode))
+        return WM_ERR_INVALID_ARGUMENT;
+
+    try {
+        wm::Plan plan;
+        if (!wm::build_plan(plan, img.width, img.height, result->length, key,
+                            scheme))
+            return WM_ERR_UNVERIFIABLE;
+
+        bool ok = wm::extract_image(
+            plan,
+            img,
+            result->bits,
+            result->confidence,
+            to_threads(options ? options->threads : 0),
+            mode
+        );
+
+        if (!ok)
+            return WM_ERR_UNVERIFIABLE;
+    } catch (const std::bad_alloc&) {
+        return WM_ERR_INTERNAL;
+    }
+
+    aggregate_result(result);
+
+    return WM_OK;
+}
+
+// ----------------------------
+// Soft-decision extraction
+// ----------------------------
+static bool valid_soft_result(const WM_ExtractResultSoft* result) {
+    return result &&
+           result->struct_size >= sizeof(WM_ExtractResultSoft) &&
+           result->base.bits && result->base.confidence &&
+           result->base.length != 0;
+}
+
+static WM_Status extract_soft_with_plan(
+    const wm::Plan& plan,
+    const WM_Image* image,
+    WM_ExtractResultSoft* result,
+    const WM_ExtractOptions* options,
+    wm::ExtractMode mode
+) {
+    wm::Image img;
+    img.width  = image->width;
+    img.height = image->height;
+    img.Y      = image->y;
+
+    std::vector<float> own;
+    float* z = result->scores;
+    if (!z) {
+        own.resize(result->base.length);
+        z = own.data();
+    }
+
+    bool ok = wm::extract_image_soft(
+        plan,
         img,
-        result->bits,
-        result->confidence,
-        result->length,
-        key
+        result->base.bits,
+        result->base.confidence,
+        z,
+        to_threads(options ? options->threads : 0),
+        mode
     );
 
     if (!ok)
         return WM_ERR_UNVERIFIABLE;
 
-    // ----------------------------
-    // Aggregate confidence
-    // ----------------------------
-    float sum = 0.0f;
-    float min_conf = 1.0f;
-    uint32_t weak = 0;
+    aggregate_soft(result, z);
 
-    for (uint32_t i = 0; i < result->length; ++i) {
-        float c = result->confidence[i];
-        sum += c;
-        if (c < min_conf) min_conf = c;
-        if (c < 0.6f) weak++;
+    return WM_OK;
+}
+
+WM_Status wm_extract_soft(
+    const WM_Image* image,
+    uint64_t key,
+    WM_ExtractResultSoft* result,
+    const WM_ExtractOptions* options
+) {
+    if (!image || !image->y || !valid_soft_result(result))
+        return WM_ERR_INVALID_ARGUMENT;
+
+    wm::Scheme scheme;
+    if (!to_scheme(options ? &options->scheme : nullptr, scheme))
+        return WM_ERR_INVALID_ARGUMENT;
+
+    wm::ExtractMode mode;
+    if (!to_mode(options, mode))
+        return WM_ERR_INVALID_ARGUMENT;
+
+    try {
+        wm::Plan plan;
+        if (!wm::build_plan(plan, image->width, image->height,
+                            result->base.length, key, scheme))
+            return WM_ERR_UNVERIFIABLE;
+
+        return extract_soft_with_plan(plan, image, result, options, mode);
+    } catch (const std::bad_alloc&) {
+        return WM_ERR_INTERNAL;
     }
+}
 
-    result->mean_confidence = sum / result->length;
-    result->min_confidence  = min_conf;
-    result->verdict = compute_verdict(
-        result->mean_confidence,
-        result->min_confidence,
-        weak,
-        result->length
-    );
+// ----------------------------
+// Contexts
+// ----------------------------
+WM_Status wm_context_create(
+    uint32_t width,
+    uint32_t height,
+    uint32_t payload_len,
+    uint64_t key,
+    const WM_Scheme* scheme,
+    WM_Context** out
+) {
+    if (!out || payload_len == 0)
+        return WM_ERR_INVALID_ARGUMENT;
+
+    *out = nullptr;
+
+    wm::Scheme s;
+    if (!to_scheme(scheme, s))
+        return WM_ERR_INVALID_ARGUMENT;
+
+    if (width == 0 || height == 0 || width % 32 != 0 || height % 32 != 0)
+        return WM_ERR_INVALID_DIMENSIONS;
+
+    WM_Context* ctx = new (std::nothrow) WM_Context;
+    if (!ctx)
+        return WM_ERR_INTERNAL;
+
+    bool ok = false;
+    try {
+        ok = wm::build_plan(ctx->plan, width, height, payload_len, key, s);
+    } catch (const std::bad_alloc&) {
+        delete ctx;
+        return WM_ERR_INTERNAL;
+    }
+
+    if (!ok) {
+        delete ctx;
+        return WM_ERR_INSUFFICIENT_CAPACITY;
+    }
+
+    *out = ctx;
+    return WM_OK;
+}
+
+void wm_context_destroy(WM_Context* ctx) {
+    delete ctx;
+}
+
+WM_Status wm_embed_ctx(
+    const WM_Context* ctx,
+    WM_Image* image,
+    const WM_Payload* payload,
+    float alpha,
+    const WM_EmbedOptions* options
+) {
+    if (!ctx || !image || !image->y || !payload || !payload->bits)
+        return WM_ERR_INVALID_ARGUMENT;
+
+    if (payload->length != ctx->plan.payload_len)
+        return WM_ERR_INVALID_ARGUMENT;
+
+    if (image->width != ctx->plan.width || image->height != ctx->plan.height)
+        return WM_ERR_INVALID_DIMENSIONS;
+
+    uint32_t threads = 1;
+    if (options) {
+        if (options->strength_scale > 0.0f)
+            alpha *= options->strength_scale;
+        threads = to_threads(options->threads);
+    }
+
+    wm::Image img;
+    img.width  = image->width;
+    img.height = image->height;
+    img.Y      = image->y;
+
+    bool ok = false;
+    try {
+        ok = wm::embed_image(ctx->plan, img, payload->bits, alpha, threads);
+    } catch (const std::bad_alloc&) {
+        return WM_ERR_INTERNAL;
+    }
+
+    return ok ? WM_OK : WM_ERR_INVALID_DIMENSIONS;
+}
+
+WM_Status wm_extract_ctx(
+    const WM_Context* ctx,
+    const WM_Image* image,
+    WM_ExtractResult* result,
+    const WM_ExtractOptions* options
+) {
+    if (!ctx || !image || !image->y)
+        return WM_ERR_INVALID_ARGUMENT;
+
+    if (!result || !result->bits || !result->confidence)
+        return WM_ERR_INVALID_ARGUMENT;
+
+    if (result->length != ctx->plan.payload_len)
+        return WM_ERR_INVALID_ARGUMENT;
+
+    if (image->width != ctx->plan.width || image->height != ctx->plan.height)
+        return WM_ERR_INVALID_DIMENSIONS;
+
+    wm::ExtractMode mode;
+    if (!to_mode(options, mode))
+        return WM_ERR_INVALID_ARGUMENT;
+
+    wm::Image img;
+    img.width  = image->width;
+    img.height = image->height;
+    img.Y      = image->y;
+
+    bool ok = false;
+    try {
+        ok = wm::extract_image(
+            ctx->plan,
+            img,
+            result->bits,
+            result->confidence,
+            to_threads(options ? options->threads : 0),
+            mode
+        );
+    } catch (const std::bad_alloc&) {
+        return WM_ERR_INTERNAL;
+    }
+
+    if (!ok)
+        return WM_ERR_UNVERIFIABLE;
 
+    aggregate_result(result);
+
+    return WM_OK;
+}
+
+WM_Status wm_extract_soft_ctx(
+    const WM_Context* ctx,
+    const WM_Image* image,
+    WM_ExtractResultSoft* result,
+    const WM_ExtractOptions* options
+) {
+    if (!ctx || !image || !image->y || !valid_soft_result(result))
+        return WM_ERR_INVALID_ARGUMENT;
+
+    if (result->base.length != ctx->plan.payload_len)
+        return WM_ERR_INVALID_ARGUMENT;
+
+    if (image->width != ctx->plan.width || image->height != ctx->plan.height)
+        return WM_ERR_INVALID_DIMENSIONS;
+
+    wm::ExtractMode mode;
+    if (!to_mode(options, mode))
+        return WM_ERR_INVALID_ARGUMENT;
+
+    try {
+        return extract_soft_with_plan(ctx->plan, image, result, options,
+                                      mode);
+    } catch (const std::bad_alloc&) {
+        return WM_ERR_INTERNAL;
+    }
+}
+
+// ----------------------------
+// Multi-key extraction
+// ----------------------------
+WM_Status wm_extract_multikey(
+    const WM_Image* image,
+    const uint64_t* keys,
+    uint32_t key_count,
+    WM_ExtractResult* results,
+    uint32_t* ranking,
+    const WM_ExtractOptions* options,
+    WM_Status* statuses
+) {
+    if (key_count == 0)
+        return WM_OK;
+
+    if (!image || !image->y || !keys || !results || !statuses)
+        return WM_ERR_INVALID_ARGUMENT;
+
+    wm::Scheme scheme;
+    if (!to_scheme(options ? &options->scheme : nullptr, scheme))
+        return WM_ERR_INVALID_ARGUMENT;
+
+    const uint32_t threads = to_threads(options ? options->threads : 0);
+
+    wm::Image img;
+    img.width  = image->width;
+    img.height = image->height;
+    img.Y      = image->y;
+
+    try {
+        // Key-independent: masked coefficients of every block, once
+        std::vector<float> features(
+            wm::feature_count(image->width, image->height));
+
+        if (!wm::compute_features(img, features.data(), threads)) {
+            for (uint32_t i = 0; i < key_count; ++i)
+                statuses[i] = WM_ERR_UNVERIFIABLE;
+        } else {
+            wm::parallel_for(key_count, threads, [&](uint32_t i) {
+                WM_ExtractResult* r = &results[i];
+                if (!r->bits || !r->confidence || r->length == 0) {
+                    statuses[i] = WM_ERR_INVALID_ARGUMENT;
+                    return;
+                }
+
+                try {
+                    wm::Plan plan;
+                    if (!wm::build_plan(plan, image->width, image->height,
+                                        r->length, keys[i], scheme)) {
+                        statuses[i] = WM_ERR_UNVERIFIABLE;
+                        return;
+                    }
+
+                    wm::extract_features(plan, features.data(), r->bits,
+                                         r->confidence);
+                    aggregate_result(r);
+                    statuses[i] = WM_OK;
+                } catch (const std::bad_alloc&) {
+                    statuses[i] = WM_ERR_INTERNAL;
+                }
+            });
+        }
+
+        if (ranking) {
+            for (uint32_t i = 0; i < key_count; ++i)
+                ranking[i] = i;
+
+            std::stable_sort(ranking, ranking + key_count,
+                             [&](uint32_t a, uint32_t b) {
+                bool ok_a = statuses[a] == WM_OK;
+                bool ok_b = statuses[b] == WM_OK;
+                if (ok_a != ok_b)
+                    return ok_a;
+                if (!ok_a)
+                    return false;
+                if (results[a].mean_confidence != results[b].mean_confidence)
+                    return results[a].mean_confidence >
+                           results[b].mean_confidence;
+                return results[a].min_confidence > results[b].min_confidence;
+            });
+        }
+    } catch (const std::bad_alloc&) {
+        return WM_ERR_INTERNAL;
+    }
+
+    return WM_OK;
+}
+
+// ----------------------------
+// Feature files
+// ----------------------------
+WM_Status wm_features_compute(
+    const WM_Image* image,
+    const WM_ExtractOptions* options,
+    WM_Features** out
+) {
+    if (!out)
+        return WM_ERR_INVALID_ARGUMENT;
+
+    *out = nullptr;
+
+    if (!image || !image->y)
+        return WM_ERR_INVALID_ARGUMENT;
+
+    const uint32_t W = image->width;
+    const uint32_t H = image->height;
+    if (W == 0 || H == 0 || W % 32 != 0 || H % 32 != 0)
+        return WM_ERR_INVALID_DIMENSIONS;
+
+    WM_Features* f = new (std::nothrow) WM_Features;
+    if (!f)
+        return WM_ERR_INTERNAL;
+
+    try {
+        // Built as a file image, so saving is a single write
+        constexpr size_t header_floats =
+            sizeof(wm::FeatureFileHeader) / sizeof(float);
+        f->owned.resize(header_floats + wm::feature_count(W, H));
+
+        wm::FeatureFileHeader header = wm::make_feature_header(W, H);
+        std::memcpy(f->owned.data(), &header, sizeof header);
+
+        wm::Image img;
+        img.width  = W;
+        img.height = H;
+        img.Y      = image->y;
+
+        wm::compute_features(img, f->owned.data() + header_floats,
+                             to_threads(options ? options->threads : 0));
+    } catch (const std::bad_alloc&) {
+        delete f;
+        return WM_ERR_INTERNAL;
+    }
+
+    f->width = W;
+    f->height = H;
+    f->bytes = f->owned.data();
+    f->size = f->owned.size() * sizeof(float);
+    f->data = f->owned.data() +
+              sizeof(wm::FeatureFileHeader) / sizeof(float);
+
+    *out = f;
+    return WM_OK;
+}
+
+// Takes over `file` on success
+static WM_Status open_features(const void* data, size_t size,
+                               wm::MappedFile* file, WM_Features** out)
+{
+    uint32_t W, H;
+    const float* features;
+    if (!wm::parse_feature_file(data, size, W, H, features))
+        return WM_ERR_INVALID_ARGUMENT;
+
+    WM_Features* f = new (std::nothrow) WM_Features;
+    if (!f)
+        return WM_ERR_INTERNAL;
+
+    f->width = W;
+    f->height = H;
+    f->data = features;
+    f->bytes = data;
+    f->size = size;
+    if (file) {
+        f->file = *file;
+        *file = wm::MappedFile{};
+    }
+
+    *out = f;
     return WM_OK;
 }
 
+WM_Status wm_features_open(
+    const void* data,
+    size_t size,
+    WM_Features** out
+) {
+    if (!out)
+        return WM_ERR_INVALID_ARGUMENT;
+
+    *out = nullptr;
+
+    if (!data)
+        return WM_ERR_INVALID_ARGUMENT;
+
+    return open_features(data, size, nullptr, out);
+}
+
+WM_Status wm_features_map(const char* path, WM_Features** out) {
+    if (!out)
+        return WM_ERR_INVALID_ARGUMENT;
+
+    *out = nullptr;
+
+    if (!path)
+        return WM_ERR_INVALID_ARGUMENT;
+
+    wm::MappedFile file;
+    if (!wm::map_file(path, file))
+        return WM_ERR_IO;
+
+    WM_Status st = open_features(file.data, file.size, &file, out);
+    wm::unmap_file(file);   // no-op once taken over
+
+    return st;
+}
+
+WM_Status wm_features_save(const WM_Features* features, const char* path) {
+    if (!features || !path)
+        return WM_ERR_INVALID_ARGUMENT;
+
+    return wm::write_file(path, features->bytes, features->size)
+               ? WM_OK
+               : WM_ERR_IO;
+}
+
+WM_Status wm_features_bytes(
+    const WM_Features* features,
+    const void** data,
+    size_t* size
+) {
+    if (!features || !data || !size)
+        return WM_ERR_INVALID_ARGUMENT;
+
+    *data = features->bytes;
+    *size = features->size;
+    return WM_OK;
+}
+
+void wm_features_destroy(WM_Features* features) {
+    delete features;
+}
+
+WM_Status wm_extract_features(
+    const WM_Features* features,
+    uint64_t key,
+    WM_ExtractResult* result,
+    const WM_ExtractOptions* options
+) {
+    if (!features || !result || !result->bits || !result->confidence ||
+        result->length == 0)
+        return WM_ERR_INVALID_ARGUMENT;
+
+    wm::Scheme scheme;
+    if (!to_scheme(options ? &options->scheme : nullptr, scheme))
+        return WM_ERR_INVALID_ARGUMENT;
+
+    try {
+        wm::Plan plan;
+        if (!wm::build_plan(plan, features->width, features->height,
+                            result->length, key, scheme))
+            return WM_ERR_UNVERIFIABLE;
+
+        wm::extract_features(plan, features->data, result->bits,
+                             result->confidence);
+    } catch (const std::bad_alloc&) {
+        return WM_ERR_INTERNAL;
+    }
+
+    aggregate_result(result);
+    return WM_OK;
+}
+
+WM_Status wm_extract_features_ctx(
+    const WM_Context* ctx,
+    const WM_Features* features,
+    WM_ExtractResult* result
+) {
+    if (!ctx || !features || !result || !result->bits ||
+        !result->confidence)
+        return WM_ERR_INVALID_ARGUMENT;
+
+    if (result->length != ctx->plan.payload_len)
+        return WM_ERR_INVALID_ARGUMENT;
+
+    if (features->width != ctx->plan.width ||
+        features->height != ctx->plan.height)
+        return WM_ERR_INVALID_DIMENSIONS;
+
+    try {
+        wm::extract_features(ctx->plan, features->data, result->bits,
+                             result->confidence);
+    } catch (const std::bad_alloc&) {
+        return WM_ERR_INTERNAL;
+    }
+
+    aggregate_result(result);
+    return WM_OK;
+}
+
+// ----------------------------
+// Sequential verification
+// ----------------------------
+static bool to_sequential(const WM_SequentialOptions* in,
+                          wm::SequentialParams& out)
+{
+    out = wm::SequentialParams{};
+    if (!in)
+        return true;
+
+    if (in->false_accept != 0.0f)
+        out.false_accept = in->false_accept;
+    if (in->false_reject != 0.0f)
+        out.false_reject = in->false_reject;
+    if (in->block_accuracy != 0.0f)
+        out.block_accuracy = in->block_accuracy;
+
+    return out.false_accept > 0.0f && out.false_accept < 0.5f &&
+           out.false_reject > 0.0f && out.false_reject < 0.5f &&
+           out.block_accuracy > 0.5f && out.block_accuracy < 1.0f;
+}
+
+static WM_Status extract_sequential_with_plan(
+    const wm::Plan& plan,
+    const WM_Image* image,
+    WM_ExtractResult* result,
+    const wm::SequentialParams& params,
+    uint32_t* blocks_read
+) {
+    wm::Image img;
+    img.width  = image->width;
+    img.height = image->height;
+    img.Y      = image->y;
+
+    wm::SequentialOutcome outcome;
+    bool ok = wm::extract_sequential(plan, img, params, result->bits,
+                                     result->confidence, outcome);
+    if (!ok)
+        return WM_ERR_UNVERIFIABLE;
+
+    aggregate_result(result);
+
+    if (outcome.verdict == wm::SequentialVerdict::Verified)
+        result->verdict = WM_VERDICT_VERIFIED;
+    else if (outcome.verdict == wm::SequentialVerdict::Tampered)
+        result->verdict = WM_VERDICT_TAMPERED;
+
+    if (blocks_read)
+        *blocks_read = outcome.blocks_read;
+
+    return WM_OK;
+}
+
+WM_Status wm_extract_sequential(
+    const WM_Image* image,
+    uint64_t key,
+    WM_ExtractResult* result,
+    const WM_ExtractOptions* options,
+    const WM_SequentialOptions* seq,
+    uint32_t* blocks_read
+) {
+    if (!image || !image->y || !result || !result->bits ||
+        !result->confidence || result->length == 0)
+        return WM_ERR_INVALID_ARGUMENT;
+
+    wm::Scheme scheme;
+    if (!to_scheme(options ? &options->scheme : nullptr, scheme))
+        return WM_ERR_INVALID_ARGUMENT;
+
+    wm::SequentialParams params;
+    if (!to_sequential(seq, params))
+        return WM_ERR_INVALID_ARGUMENT;
+
+    // Early exit reads few blocks, so the Feistel scheme skips the tables
+    const bool tables =
+        scheme.permutation != wm::PermutationScheme::Feistel;
+
+    try {
+        wm::Plan plan;
+        if (!wm::build_plan(plan, image->width, image->height,
+                            result->length, key, scheme, tables))
+            return WM_ERR_UNVERIFIABLE;
+
+        return extract_sequential_with_plan(plan, image, result, params,
+                                            blocks_read);
+    } catch (const std::bad_alloc&) {
+        return WM_ERR_INTERNAL;
+    }
+}
+
+WM_Status wm_extract_sequential_ctx(
+    const WM_Context* ctx,
+    const WM_Image* image,
+    WM_ExtractResult* result,
+    const WM_SequentialOptions* seq,
+    uint32_t* blocks_read
+) {
+    if (!ctx || !image || !image->y || !result || !result->bits ||
+        !result->confidence)
+        return WM_ERR_INVALID_ARGUMENT;
+
+    if (result->length != ctx->plan.payload_len)
+        return WM_ERR_INVALID_ARGUMENT;
+
+    if (image->width != ctx->plan.width || image->height != ctx->plan.height)
+        return WM_ERR_INVALID_DIMENSIONS;
+
+    wm::SequentialParams params;
+    if (!to_sequential(seq, params))
+        return WM_ERR_INVALID_ARGUMENT;
+
+    return extract_sequential_with_plan(ctx->plan, image, result, params,
+                                        blocks_read);
+}
+
+// ----------------------------
+// Presence pre-screen
+// ----------------------------
+static WM_Status detect_presence_with_plan(
+    const wm::Plan& plan,
+    const WM_Image* image,
+    const WM_PresenceOptions* presence,
+    WM_PresenceResult* result
+) {
+    wm::PresenceParams params;
+    if (presence && presence->blocks_per_bit != 0)
+        params.blocks_per_bit = presence->blocks_per_bit;
+
+    wm::Image img;
+    img.width  = image->width;
+    img.height = image->height;
+    img.Y      = image->y;
+
+    wm::PresenceOutcome outcome;
+    if (!wm::detect_presence(plan, img, params, outcome))
+        return WM_ERR_UNVERIFIABLE;
+
+    result->score = outcome.score;
+    result->false_positive_bound = outcome.false_positive_bound;
+    result->blocks_read = outcome.blocks_read;
+
+    return WM_OK;
+}
+
+WM_Status wm_detect_presence(
+    const WM_Image* image,
+    uint64_t key,
+    uint32_t payload_len,
+    const WM_ExtractOptions* options,
+    const WM_PresenceOptions* presence,
+    WM_PresenceResult* result
+) {
+    if (!image || !image->y || !result || payload_len == 0)
+        return WM_ERR_INVALID_ARGUMENT;
+
+    wm::Scheme scheme;
+    if (!to_scheme(options ? &options->scheme : nullptr, scheme))
+        return WM_ERR_INVALID_ARGUMENT;
+
+    // Few blocks are read, so the Feistel scheme skips the tables
+    const bool tables =
+        scheme.permutation != wm::PermutationScheme::Feistel;
+
+    try {
+        wm::Plan plan;
+        if (!wm::build_plan(plan, image->width, image->height,
+                            payload_len, key, scheme, tables))
+            return WM_ERR_UNVERIFIABLE;
+
+        return detect_presence_with_plan(plan, image, presence, result);
+    } catch (const std::bad_alloc&) {
+        return WM_ERR_INTERNAL;
+    }
+}
+
+WM_Status wm_detect_presence_ctx(
+    const WM_Context* ctx,
+    const WM_Image* image,
+    const WM_PresenceOptions* presence,
+    WM_PresenceResult* result
+) {
+    if (!ctx || !image || !image->y || !result)
+        return WM_ERR_INVALID_ARGUMENT;
+
+    if (image->width != ctx->plan.width || image->height != ctx->plan.height)
+        return WM_ERR_INVALID_DIMENSIONS;
+
+    return detect_presence_with_plan(ctx->plan, image, presence, result);
+}
+
+// ----------------------------
+// 8-bit RGB embedding
+// ----------------------------
+static bool to_pixels(const WM_PixelBuffer* in, wm::PixelImage& out) {
+    if (!in || !in->data)
+        return false;
+
+    switch (in->format) {
+        case WM_PIXEL_RGB8:  out.format = wm::PixelFormat::RGB8;  break;
+        case WM_PIXEL_RGBA8: out.format = wm::PixelFormat::RGBA8; break;
+        case WM_PIXEL_BGRA8: out.format = wm::PixelFormat::BGRA8; break;
+        default:
+            return false;
+    }
+
+    out.width  = in->width;
+    out.height = in->height;
+    out.pitch  = in->pitch;
+    out.data   = in->data;
+
+    return out.pitch >= size_t(out.width) * wm::bytes_per_pixel(out.format);
+}
+
+static WM_Status embed_pixels_with_plan(
+    const wm::Plan& plan,
+    wm::PixelImage& img,
+    const WM_Payload* payload,
+    float alpha,
+    const WM_EmbedOptions* options
+) {
+    uint32_t threads = 1;
+    if (options) {
+        if (options->strength_scale > 0.0f)
+            alpha *= options->strength_scale;
+        threads = to_threads(options->threads);
+    }
+
+    bool ok = wm::embed_pixels(plan, img, payload->bits, alpha, threads);
+
+    return ok ? WM_OK : WM_ERR_INVALID_DIMENSIONS;
+}
+
+WM_Status wm_embed_pixels(
+    WM_PixelBuffer* image,
+    const WM_Payload* payload,
+    uint64_t key,
+    float alpha,
+    const WM_EmbedOptions* options
+) {
+    if (!payload || !payload->bits || payload->length == 0)
+        return WM_ERR_INVALID_ARGUMENT;
+
+    wm::PixelImage img;
+    if (!to_pixels(image, img))
+        return WM_ERR_INVALID_ARGUMENT;
+
+    wm::Scheme scheme;
+    if (!to_scheme(options ? &options->scheme : nullptr, scheme))
+        return WM_ERR_INVALID_ARGUMENT;
+
+    try {
+        wm::Plan plan;
+        if (!wm::build_plan(plan, img.width, img.height, payload->length,
+                            key, scheme))
+            return WM_ERR_INVALID_DIMENSIONS;
+
+        return embed_pixels_with_plan(plan, img, payload, alpha, options);
+    } catch (const std::bad_alloc&) {
+        return WM_ERR_INTERNAL;
+    }
+}
+
+WM_Status wm_embed_pixels_ctx(
+    const WM_Context* ctx,
+    WM_PixelBuffer* image,
+    const WM_Payload* payload,
+    float alpha,
+    const WM_EmbedOptions* options
+) {
+    if (!ctx || !payload || !payload->bits)
+        return WM_ERR_INVALID_ARGUMENT;
+
+    if (payload->length != ctx->plan.payload_len)
+        return WM_ERR_INVALID_ARGUMENT;
+
+    wm::PixelImage img;
+    if (!to_pixels(image, img))
+        return WM_ERR_INVALID_ARGUMENT;
+
+    if (img.width != ctx->plan.width || img.height != ctx->plan.height)
+        return WM_ERR_INVALID_DIMENSIONS;
+
+    return embed_pixels_with_plan(ctx->plan, img, payload, alpha, options);
+}
+
+// ----------------------------
+// Multi-layer embedding
+// ----------------------------
+WM_Status wm_embed_layers(
+    WM_Image* image,
+    const WM_EmbedLayer* layers,
+    uint32_t count,
+    const WM_EmbedOptions* options
+) {
+    if (!image || !image->y || !layers || count == 0)
+        return WM_ERR_INVALID_ARGUMENT;
+
+    float scale = 1.0f;
+    uint32_t threads = 1;
+    if (options) {
+        if (options->strength_scale > 0.0f)
+            scale = options->strength_scale;
+        threads = to_threads(options->threads);
+    }
+
+    wm::Scheme scheme;
+    if (!to_scheme(options ? &options->scheme : nullptr, scheme))
+        return WM_ERR_INVALID_ARGUMENT;
+
+    try {
+        // Plans built here; layers with a context borrow its plan
+        std::vector<wm::Plan> built(count);
+        std::vector<wm::EmbedLayer> plan_layers(count);
+
+        for (uint32_t l = 0; l < count; ++l) {
+            const WM_EmbedLayer& in = layers[l];
+            if (!in.payload || !in.payload->bits || in.payload->length == 0)
+                return WM_ERR_INVALID_ARGUMENT;
+
+            const wm::Plan* plan = nullptr;
+            if (in.context) {
+                plan = &in.context->plan;
+                if (in.payload->length != plan->payload_len)
+                    return WM_ERR_INVALID_ARGUMENT;
+                if (plan->width != image->width ||
+                    plan->height != image->height)
+                    return WM_ERR_INVALID_DIMENSIONS;
+            } else {
+                if (!wm::build_plan(built[l], image->width, image->height,
+                                    in.payload->length, in.key, scheme))
+                    return WM_ERR_INVALID_DIMENSIONS;
+                plan = &built[l];
+            }
+
+            plan_layers[l] = { plan, in.payload->bits, in.alpha * scale };
+        }
+
+        wm::Image img;
+        img.width  = image->width;
+        img.height = image->height;
+        img.Y      = image->y;
+
+        bool ok = wm::embed_image_layers(img, plan_layers.data(), count,
+                                         threads);
+
+        return ok ? WM_OK : WM_ERR_INVALID_DIMENSIONS;
+    } catch (const std::bad_alloc&) {
+        return WM_ERR_INTERNAL;
+    }
+}
+
+// ----------------------------
+// Pattern cache
+// ----------------------------
+WM_Status wm_pattern_create(
+    const WM_Context* ctx,
+    const WM_Payload* payload,
+    float alpha,
+    uint32_t format,
+    const WM_EmbedOptions* options,
+    WM_Pattern** out
+) {
+    if (!out || !ctx || !payload || !payload->bits)
+        return WM_ERR_INVALID_ARGUMENT;
+
+    *out = nullptr;
+
+    if (payload->length != ctx->plan.payload_len)
+        return WM_ERR_INVALID_ARGUMENT;
+
+    wm::PatternFormat f;
+    switch (format) {
+        case WM_PATTERN_FLOAT32: f = wm::PatternFormat::Float32; break;
+        case WM_PATTERN_INT16:   f = wm::PatternFormat::Int16;   break;
+        default:
+            return WM_ERR_INVALID_ARGUMENT;
+    }
+
+    uint32_t threads = 1;
+    if (options) {
+        if (options->strength_scale > 0.0f)
+            alpha *= options->strength_scale;
+        threads = to_threads(options->threads);
+    }
+
+    WM_Pattern* pattern = new (std::nothrow) WM_Pattern;
+    if (!pattern)
+        return WM_ERR_INTERNAL;
+
+    bool ok = false;
+    try {
+        ok = wm::build_pattern(pattern->pattern, ctx->plan, payload->bits,
+                               alpha, f, threads);
+    } catch (const std::bad_alloc&) {
+        delete pattern;
+        return WM_ERR_INTERNAL;
+    }
+
+    if (!ok) {
+        delete pattern;
+        return WM_ERR_INTERNAL;
+    }
+
+    *out = pattern;
+    return WM_OK;
+}
+
+void wm_pattern_destroy(WM_Pattern* pattern) {
+    delete pattern;
+}
+
+WM_Status wm_embed_pattern(
+    const WM_Pattern* pattern,
+    WM_Image* image,
+    const WM_EmbedOptions* options
+) {
+    if (!pattern || !image || !image->y)
+        return WM_ERR_INVALID_ARGUMENT;
+
+    wm::Image img;
+    img.width  = image->width;
+    img.height = image->height;
+    img.Y      = image->y;
+
+    bool ok = wm::apply_pattern(pattern->pattern, img,
+                                to_threads(options ? options->threads : 0));
+
+    return ok ? WM_OK : WM_ERR_INVALID_DIMENSIONS;
+}
+
+// ----------------------------
+// Fan-out
+// ----------------------------
+WM_Status wm_embed_fanout(
+    const WM_Context* ctx,
+    const float* source,
+    const WM_Payload* payloads,
+    uint32_t count,
+    float alpha,
+    const WM_EmbedOptions* options,
+    float* const* outputs,
+    WM_FanoutCallback callback,
+    void* user
+) {
+    if (!ctx || !source || (!outputs && !callback))
+        return WM_ERR_INVALID_ARGUMENT;
+
+    if (count == 0)
+        return WM_OK;
+
+    if (!payloads)
+        return WM_ERR_INVALID_ARGUMENT;
+
+    const wm::Plan& plan = ctx->plan;
+
+    for (uint32_t i = 0; i < count; ++i) {
+        if (!payloads[i].bits || payloads[i].length != plan.payload_len)
+            return WM_ERR_INVALID_ARGUMENT;
+        if (outputs && !outputs[i])
+            return WM_ERR_INVALID_ARGUMENT;
+    }
+
+    uint32_t threads = 1;
+    if (options) {
+        if (options->strength_scale > 0.0f)
+            alpha *= options->strength_scale;
+        threads = to_threads(options->threads);
+    }
+
+    const uint32_t W = plan.width;
+    const uint32_t rows = plan.layout.blocks_y;
+
+    try {
+        if (outputs) {
+            // Every (output, tile row) pair is independent; chunks keep
+            // the task index within 32 bits
+            const uint32_t chunk = UINT32_MAX / rows;
+
+            for (uint32_t first = 0; first < count; first += chunk) {
+                uint32_t n = count - first < chunk ? count - first : chunk;
+
+                wm::parallel_for(n * rows, threads, [&](uint32_t task) {
+                    uint32_t i = first + task / rows;
+                    uint32_t by = task % rows;
+                    size_t offset = size_t(by) * 32 * W;
+
+                    wm::fanout_tile_row(source + offset, outputs[i] + offset,
+                                        W, by, plan, payloads[i].bits, alpha);
+                });
+            }
+        } else {
+            std::vector<float> plane(size_t(W) * plan.height);
+
+            for (uint32_t i = 0; i < count; ++i) {
+                wm::fanout_embed(plan, source, payloads[i].bits, alpha,
+                                 plane.data(), threads);
+                callback(i, plane.data(), user);
+            }
+        }
+    } catch (const std::bad_alloc&) {
+        return WM_ERR_INTERNAL;
+    }
+
+    return WM_OK;
+}
+
+// ----------------------------
+// Batches
+// ----------------------------
+// Largest images first, so the work-stealing scheduler starts every
+// thread on a big item and fills in with small ones
+static std::vector<uint32_t> largest_first(const WM_Image* images,
+                                           uint32_t count)
+{
+    std::vector<uint32_t> order(count);
+    for (uint32_t i = 0; i < count; ++i)
+        order[i] = i;
+
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return uint64_t(images[a].width) * images[a].height >
+               uint64_t(images[b].width) * images[b].height;
+    });
+
+    return order;
+}
+
+WM_Status wm_embed_batch(
+    WM_Image* images,
+    const WM_Payload* payloads,
+    uint32_t count,
+    uint64_t key,
+    float alpha,
+    const WM_EmbedOptions* options,
+    WM_Status* statuses
+) {
+    if (count == 0)
+        return WM_OK;
+
+    if (!images || !payloads || !statuses)
+        return WM_ERR_INVALID_ARGUMENT;
+
+    WM_EmbedOptions per_image = {};
+    if (options)
+        per_image = *options;
+    per_image.threads = 1;
+
+    try {
+        std::vector<uint32_t> order = largest_first(images, count);
+
+        wm::ThreadPool::shared().parallel_for_stealing(
+            order.data(),
+            count,
+            to_threads(options ? options->threads : 0),
+            [&](uint32_t i) {
+                try {
+                    statuses[i] = wm_embed_ex(
+                        &images[i], &payloads[i], key, alpha, &per_image);
+                } catch (const std::bad_alloc&) {
+                    statuses[i] = WM_ERR_INTERNAL;
+                }
+            }
+        );
+    } catch (const std::bad_alloc&) {
+        return WM_ERR_INTERNAL;
+    }
+
+    return WM_OK;
+}
+
+WM_Status wm_extract_batch(
+    const WM_Image* images,
+    uint32_t count,
+    uint64_t key,
+    WM_ExtractResult* results,
+    const WM_ExtractOptions* options,
+    WM_Status* statuses
+) {
+    if (count == 0)
+        return WM_OK;
+
+    if (!images || !results || !statuses)
+        return WM_ERR_INVALID_ARGUMENT;
+
+    WM_ExtractOptions per_image = {};
+    if (options)
+        per_image = *options;
+    per_image.threads = 1;
+
+    try {
+        std::vector<uint32_t> order = largest_first(images, count);
+
+        wm::ThreadPool::shared().parallel_for_stealing(
+            order.data(),
+            count,
+            to_threads(options ? options->threads : 0),
+            [&](uint32_t i) {
+                try {
+                    statuses[i] = wm_extract_ex(
+                        &images[i], key, &results[i], &per_image);
+                } catch (const std::bad_alloc&) {
+                    statuses[i] = WM_ERR_INTERNAL;
+                }
+            }
+        );
+    } catch (const std::bad_alloc&) {
+        return WM_ERR_INTERNAL;
+    }
+
+    return WM_OK;
+}
+
+// ----------------------------
+// Streaming embed
+// ----------------------------
+WM_Status wm_embed_stream_create(
+    uint32_t width,
+    uint32_t height,
+    const WM_Payload* payload,
+    uint64_t key,
+    float alpha,
+    const WM_Scheme* scheme,
+    WM_EmbedStream** out
+) {
+    if (!out || !payload || !payload->bits || payload->length == 0)
+        return WM_ERR_INVALID_ARGUMENT;
+
+    *out = nullptr;
+
+    wm::Scheme s;
+    if (!to_scheme(scheme, s))
+        return WM_ERR_INVALID_ARGUMENT;
+
+    WM_EmbedStream* stream = new (std::nothrow) WM_EmbedStream;
+    if (!stream)
+        return WM_ERR_INTERNAL;
+
+    bool ok = false;
+    try {
+        ok = wm::embed_stream_begin(
+            stream->s,
+            width,
+            height,
+            payload->bits,
+            payload->length,
+            key,
+            alpha,
+            s
+        );
+    } catch (const std::bad_alloc&) {
+        delete stream;
+        return WM_ERR_INTERNAL;
+    }
+
+    if (!ok) {
+        delete stream;
+        return WM_ERR_INVALID_DIMENSIONS;
+    }
+
+    *out = stream;
+    return WM_OK;
+}
+
+WM_Status wm_embed_stream_push(WM_EmbedStream* stream, float* band) {
+    if (!stream || !band)
+        return WM_ERR_INVALID_ARGUMENT;
+
+    return wm::embed_stream_push(stream->s, band)
+               ? WM_OK
+               : WM_ERR_INVALID_ARGUMENT;
+}
+
+void wm_embed_stream_destroy(WM_EmbedStream* stream) {
+    delete stream;
+}
+
+// ----------------------------
+// Streaming extraction
+// ----------------------------
+WM_Status wm_extract_stream_create(
+    uint32_t width,
+    uint32_t height,
+    uint32_t payload_len,
+    uint64_t key,
+    const WM_Scheme* scheme,
+    WM_ExtractStream** out
+) {
+    if (!out || payload_len == 0)
+        return WM_ERR_INVALID_ARGUMENT;
+
+    *out = nullptr;
+
+    wm::Scheme s;
+    if (!to_scheme(scheme, s))
+        return WM_ERR_INVALID_ARGUMENT;
+
+    WM_ExtractStream* stream = new (std::nothrow) WM_ExtractStream;
+    if (!stream)
+        return WM_ERR_INTERNAL;
+
+    bool ok = false;
+    try {
+        ok = wm::extract_stream_begin(
+            stream->s,
+            width,
+            height,
+            payload_len,
+            key,
+            s
+        );
+    } catch (const std::bad_alloc&) {
+        delete stream;
+        return WM_ERR_INTERNAL;
+    }
+
+    if (!ok) {
+        delete stream;
+        return WM_ERR_UNVERIFIABLE;
+    }
+
+    *out = stream;
+    return WM_OK;
+}
+
+WM_Status wm_extract_stream_push(WM_ExtractStream* stream, const float* band) {
+    if (!stream || !band)
+        return WM_ERR_INVALID_ARGUMENT;
+
+    return wm::extract_stream_push(stream->s, band)
+               ? WM_OK
+               : WM_ERR_INVALID_ARGUMENT;
+}
+
+WM_Status wm_extract_stream_finish(
+    WM_ExtractStream* stream,
+    WM_ExtractResult* result
+) {
+    if (!stream || !result || !result->bits || !result->confidence)
+        return WM_ERR_INVALID_ARGUMENT;
+
+    if (result->length != stream->s.plan.payload_len)
+        return WM_ERR_INVALID_ARGUMENT;
+
+    bool ok = wm::extract_stream_finish(
+        stream->s,
+        result->bits,
+        result->confidence
+    );
+
+    if (!ok)
+        return WM_ERR_INVALID_ARGUMENT;
+
+    aggregate_result(result);
+
+    return WM_OK;
+}
+
+void wm_extract_stream_destroy(WM_ExtractStream* stream) {
+    delete stream;
+}
+
 } // extern "C"
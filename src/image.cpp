@@ -1,8 +1,223 @@
 #include "wm/image.h"
+#include <cmath>
 #include <cstdlib>
+#include <cstring>
+
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define WM_IMAGE_X86 1
+#include <immintrin.h>
+#else
+#define WM_IMAGE_X86 0
+#endif
 
 namespace wm {
 
+// --------------------------------
+// Scalar rows
+// --------------------------------
+// ITU-R BT.601 luminance
+static inline float bt601(float r, float g, float b) {
+    return 0.299f * r + 0.587f * g + 0.114f * b;
+}
+
+static inline uint8_t saturate_u8(float v) {
+    float r = std::nearbyint(v);
+    return uint8_t(r < 0.0f ? 0.0f : (r > 255.0f ? 255.0f : r));
+}
+
+// R, G, B byte offsets and pixel size of each format
+template <uint32_t R, uint32_t G, uint32_t B, uint32_t BPP>
+static void luma_row_scalar(const uint8_t* px, uint32_t count, float* y) {
+    for (uint32_t i = 0; i < count; ++i, px += BPP)
+        y[i] = bt601(px[R], px[G], px[B]);
+}
+
+template <uint32_t R, uint32_t G, uint32_t B, uint32_t BPP>
+static void add_luma_row_scalar(uint8_t* px, uint32_t count,
+                                const float* delta) {
+    for (uint32_t i = 0; i < count; ++i, px += BPP) {
+        px[R] = saturate_u8(px[R] + delta[i]);
+        px[G] = saturate_u8(px[G] + delta[i]);
+        px[B] = saturate_u8(px[B] + delta[i]);
+    }
+}
+
+#if WM_IMAGE_X86
+
+// --------------------------------
+// AVX2 rows, 8 pixels per step
+// --------------------------------
+// Pixels are widened to one 32-bit lane each (channel k in byte k). RGB
+// is split into two 12-byte halves; both loads stay inside the 24 bytes.
+template <uint32_t BPP>
+__attribute__((target("avx2")))
+static inline __m256i load8(const uint8_t* px) {
+    if constexpr (BPP == 4)
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(px));
+
+    const __m128i lo_idx = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1,
+                                         6, 7, 8, -1, 9, 10, 11, -1);
+    const __m128i hi_idx = _mm_setr_epi8(4, 5, 6, -1, 7, 8, 9, -1,
+                                         10, 11, 12, -1, 13, 14, 15, -1);
+    __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(px));
+    __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(px + 8));
+
+    return _mm256_set_m128i(_mm_shuffle_epi8(hi, hi_idx),
+                            _mm_shuffle_epi8(lo, lo_idx));
+}
+
+template <uint32_t BPP>
+__attribute__((target("avx2")))
+static inline void store8(uint8_t* px, __m256i v) {
+    if constexpr (BPP == 4) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(px), v);
+        return;
+    }
+
+    // Back to 3 bytes per pixel, 12 bytes per half, no bytes past 24
+    const __m128i idx = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10,
+                                      12, 13, 14, -1, -1, -1, -1);
+    __m128i halves[2] = {
+        _mm_shuffle_epi8(_mm256_castsi256_si128(v), idx),
+        _mm_shuffle_epi8(_mm256_extracti128_si256(v, 1), idx)
+    };
+
+    for (int h = 0; h < 2; ++h) {
+        int32_t tail = _mm_extract_epi32(halves[h], 2);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(px + 12 * h), halves[h]);
+        std::memcpy(px + 12 * h + 8, &tail, sizeof tail);
+    }
+}
+
+template <uint32_t K>
+__attribute__((target("avx2")))
+static inline __m256 channel(__m256i v) {
+    return _mm256_cvtepi32_ps(_mm256_and_si256(
+        _mm256_srli_epi32(v, 8 * K), _mm256_set1_epi32(0xFF)));
+}
+
+template <uint32_t R, uint32_t G, uint32_t B, uint32_t BPP>
+__attribute__((target("avx2")))
+static void luma_row_avx2(const uint8_t* px, uint32_t count, float* y) {
+    const __m256 wr = _mm256_set1_ps(0.299f);
+    const __m256 wg = _mm256_set1_ps(0.587f);
+    const __m256 wb = _mm256_set1_ps(0.114f);
+
+    uint32_t i = 0;
+    for (; i + 8 <= count; i += 8, px += 8 * BPP) {
+        __m256i v = load8<BPP>(px);
+
+        // Same operation order as bt601, no FMA
+        __m256 sum = _mm256_add_ps(
+            _mm256_mul_ps(wr, channel<R>(v)),
+            _mm256_mul_ps(wg, channel<G>(v)));
+        sum = _mm256_add_ps(sum, _mm256_mul_ps(wb, channel<B>(v)));
+
+        _mm256_storeu_ps(y + i, sum);
+    }
+
+    luma_row_scalar<R, G, B, BPP>(px, count - i, y + i);
+}
+
+template <uint32_t K>
+__attribute__((target("avx2")))
+static inline __m256i shifted_sum(__m256i v, __m256 d) {
+    // cvtps rounds to nearest even like nearbyint; clamp to a byte
+    __m256i c = _mm256_cvtps_epi32(_mm256_add_ps(channel<K>(v), d));
+    c = _mm256_min_epi32(_mm256_max_epi32(c, _mm256_setzero_si256()),
+                         _mm256_set1_epi32(255));
+    return _mm256_slli_epi32(c, 8 * K);
+}
+
+template <uint32_t R, uint32_t G, uint32_t B, uint32_t BPP>
+__attribute__((target("avx2")))
+static void add_luma_row_avx2(uint8_t* px, uint32_t count,
+                              const float* delta) {
+    // Byte 3 is alpha in the 4-byte formats and unused for RGB
+    const __m256i alpha = _mm256_set1_epi32(int32_t(0xFF000000u));
+
+    uint32_t i = 0;
+    for (; i + 8 <= count; i += 8, px += 8 * BPP) {
+        __m256i v = load8<BPP>(px);
+        __m256 d = _mm256_loadu_ps(delta + i);
+
+        __m256i out = _mm256_and_si256(v, alpha);
+        out = _mm256_or_si256(out, shifted_sum<R>(v, d));
+        out = _mm256_or_si256(out, shifted_sum<G>(v, d));
+        out = _mm256_or_si256(out, shifted_sum<B>(v, d));
+
+        store8<BPP>(px, out);
+    }
+
+    add_luma_row_scalar<R, G, B, BPP>(px, count - i, delta + i);
+}
+
+static bool image_has_avx2() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+
+static const bool g_image_avx2 = image_has_avx2();
+
+#endif
+
+template <uint32_t R, uint32_t G, uint32_t B, uint32_t BPP>
+static void luma_row_as(const uint8_t* px, uint32_t count, float* y) {
+#if WM_IMAGE_X86
+    if (g_image_avx2) {
+        luma_row_avx2<R, G, B, BPP>(px, count, y);
+        return;
+    }
+#endif
+    luma_row_scalar<R, G, B, BPP>(px, count, y);
+}
+
+template <uint32_t R, uint32_t G, uint32_t B, uint32_t BPP>
+static void add_luma_row_as(uint8_t* px, uint32_t count,
+                            const float* delta) {
+#if WM_IMAGE_X86
+    if (g_image_avx2) {
+        add_luma_row_avx2<R, G, B, BPP>(px, count, delta);
+        return;
+    }
+#endif
+    add_luma_row_scalar<R, G, B, BPP>(px, count, delta);
+}
+
+void luma_row(const uint8_t* pixels, PixelFormat format, uint32_t count,
+              float* y_out) {
+    switch (format) {
+        case PixelFormat::RGB8:
+            luma_row_as<0, 1, 2, 3>(pixels, count, y_out);
+            break;
+        case PixelFormat::RGBA8:
+            luma_row_as<0, 1, 2, 4>(pixels, count, y_out);
+            break;
+        case PixelFormat::BGRA8:
+            luma_row_as<2, 1, 0, 4>(pixels, count, y_out);
+            break;
+    }
+}
+
+void add_luma_row(uint8_t* pixels, PixelFormat format, uint32_t count,
+                  const float* delta) {
+    switch (format) {
+        case PixelFormat::RGB8:
+            add_luma_row_as<0, 1, 2, 3>(pixels, count, delta);
+            break;
+        case PixelFormat::RGBA8:
+            add_luma_row_as<0, 1, 2, 4>(pixels, count, delta);
+            break;
+        case PixelFormat::BGRA8:
+            add_luma_row_as<2, 1, 0, 4>(pixels, count, delta);
+            break;
+    }
+}
+
+// --------------------------------
+// WM_ImageBuffer
+// --------------------------------
 WM_Status validate_image(const WM_ImageBuffer* img) {
     if (!img || !img->data)
         return WM_ERR_INVALID_ARGUMENT;
@@ -19,16 +234,9 @@ Image to_luminance(const WM_ImageBuffer* img) {
     out.height = img->height;
     out.Y = (float*)std::malloc(sizeof(float) * out.width * out.height);
 
-    const uint8_t* rgb = img->data;
-
-    for (uint32_t i = 0; i < out.width * out.height; ++i) {
-        float r = rgb[3 * i + 0];
-        float g = rgb[3 * i + 1];
-        float b = rgb[3 * i + 2];
+    // Rows are packed, so the plane is one long row
+    luma_row(img->data, PixelFormat::RGB8, out.width * out.height, out.Y);
 
-        // ITU-R BT.601 luminance
-        out.Y[i] = 0.299f * r + 0.587f * g + 0.114f * b;
-    }
     return out;
 }
 
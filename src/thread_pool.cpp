@@ -0,0 +1,245 @@
+#include "wm/thread_pool.h"
+
+#include <atomic>
+#include <exception>
+#include <memory>
+
+namespace wm {
+
+// --------------------------------
+// One team of threads running a body
+// --------------------------------
+// The caller is slot 0; helpers take the next slot when they join.
+// Helpers that are dequeued after the caller has closed the job return
+// immediately, so the caller only waits for helpers that actually joined.
+// The first exception thrown by any slot is kept and rethrown on the
+// caller once every joined helper has left the body.
+struct TeamJob {
+    const std::function<void(uint32_t)>* body;
+    std::atomic<uint32_t> next_slot{ 1 };
+
+    std::mutex mutex;
+    std::condition_variable done;
+    uint32_t active = 0;
+    bool closed = false;
+    std::exception_ptr error;
+
+    void run(uint32_t slot) {
+        try {
+            (*body)(slot);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!error)
+                error = std::current_exception();
+        }
+    }
+};
+
+ThreadPool::ThreadPool(uint32_t workers) {
+    workers_.reserve(workers);
+    for (uint32_t i = 0; i < workers; ++i)
+        workers_.emplace_back([this] { worker_loop(); });
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+
+    for (std::thread& t : workers_)
+        t.join();
+}
+
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool(
+        std::thread::hardware_concurrency() > 1
+            ? std::thread::hardware_concurrency() - 1
+            : 0
+    );
+    return pool;
+}
+
+uint32_t ThreadPool::concurrency() const {
+    return static_cast<uint32_t>(workers_.size()) + 1;
+}
+
+void ThreadPool::worker_loop() {
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+
+            if (queue_.empty())
+                return;
+
+            task = std::move(queue_.front());
+            queue_.pop_front();
+        }
+        task();
+    }
+}
+
+void ThreadPool::run_team(
+    uint32_t threads,
+    const std::function<void(uint32_t)>& body
+) {
+    auto job = std::make_shared<TeamJob>();
+    job->body = &body;
+
+    // -------------------------
+    // Helpers
+    // -------------------------
+    if (threads > 1) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (uint32_t t = 1; t < threads; ++t) {
+                queue_.emplace_back([job] {
+                    {
+                        std::lock_guard<std::mutex> job_lock(job->mutex);
+                        if (job->closed)
+                            return;
+                        ++job->active;
+                    }
+
+                    job->run(job->next_slot.fetch_add(1));
+
+                    std::lock_guard<std::mutex> job_lock(job->mutex);
+                    if (--job->active == 0)
+                        job->done.notify_one();
+                });
+            }
+        }
+        cv_.notify_all();
+    }
+
+    // -------------------------
+    // Caller takes part, then waits for helpers that joined
+    // -------------------------
+    // body lives on the caller's stack, so the job is always closed and
+    // drained before an exception from any slot propagates
+    job->run(0);
+
+    std::unique_lock<std::mutex> lock(job->mutex);
+    job->closed = true;
+    job->done.wait(lock, [&] { return job->active == 0; });
+
+    if (job->error)
+        std::rethrow_exception(job->error);
+}
+
+uint32_t ThreadPool::team_size(uint32_t threads, uint32_t count) const {
+    if (threads == 0 || threads > concurrency())
+        threads = concurrency();
+    return threads > count ? count : threads;
+}
+
+// --------------------------------
+// Shared counter
+// --------------------------------
+void ThreadPool::parallel_for(
+    uint32_t count,
+    uint32_t threads,
+    const std::function<void(uint32_t)>& fn
+) {
+    if (count == 0)
+        return;
+
+    std::atomic<uint32_t> next{ 0 };
+
+    run_team(team_size(threads, count), [&](uint32_t) {
+        for (;;) {
+            uint32_t i = next.fetch_add(1, std::memory_order_relaxed);
+            if (i >= count)
+                return;
+            fn(i);
+        }
+    });
+}
+
+// --------------------------------
+// Work stealing
+// --------------------------------
+// Items are dealt round-robin in the given order, so with a largest-first
+// order every thread starts on a big item. Owners pop from the front of
+// their deque; thieves take from the back. Deques of helpers that never
+// joined are drained by stealing.
+void ThreadPool::parallel_for_stealing(
+    const uint32_t* order,
+    uint32_t count,
+    uint32_t threads,
+    const std::function<void(uint32_t)>& fn
+) {
+    if (count == 0)
+        return;
+
+    threads = team_size(threads, count);
+
+    struct Deque {
+        std::mutex mutex;
+        std::deque<uint32_t> items;
+    };
+
+    std::vector<Deque> deques(threads);
+    for (uint32_t i = 0; i < count; ++i)
+        deques[i % threads].items.push_back(order[i]);
+
+    run_team(threads, [&](uint32_t slot) {
+        for (;;) {
+            uint32_t item = 0;
+            bool found = false;
+
+            // Own work first
+            {
+                Deque& own = deques[slot];
+                std::lock_guard<std::mutex> lock(own.mutex);
+                if (!own.items.empty()) {
+                    item = own.items.front();
+                    own.items.pop_front();
+                    found = true;
+                }
+            }
+
+            // Then steal, starting from the next thread
+            for (uint32_t k = 1; !found && k < threads; ++k) {
+                Deque& victim = deques[(slot + k) % threads];
+                std::lock_guard<std::mutex> lock(victim.mutex);
+                if (!victim.items.empty()) {
+                    item = victim.items.back();
+                    victim.items.pop_back();
+                    found = true;
+                }
+            }
+
+            // Nothing queued anywhere: items are never added after the
+            // start, so this thread is done
+            if (!found)
+                return;
+
+            fn(item);
+        }
+    });
+}
+
+uint32_t resolve_threads(uint32_t requested) {
+    uint32_t n = ThreadPool::shared().concurrency();
+    return (requested == 0 || requested > n) ? n : requested;
+}
+
+void parallel_for(
+    uint32_t count,
+    uint32_t threads,
+    const std::function<void(uint32_t)>& fn
+) {
+    if (threads == 1 || count <= 1) {
+        for (uint32_t i = 0; i < count; ++i)
+            fn(i);
+        return;
+    }
+
+    ThreadPool::shared().parallel_for(count, threads, fn);
+}
+
+} // namespace wm
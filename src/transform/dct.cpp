@@ -1,4 +1,5 @@
 #include "wm/transform/dct.h"
+#include "wm/transform/dct_table.h"
 #include <cmath>
 
 namespace wm {
@@ -11,9 +12,194 @@ static inline float alpha(int k) {
 }
 
 // -------------------------
-// Forward DCT
+// 1-D AAN forward (unscaled)
 // -------------------------
-void    dct8x8(const float* input, float* output) {
+static inline void aan_fdct_1d(float* d, uint32_t s) {
+    float tmp0 = d[0 * s] + d[7 * s];
+    float tmp7 = d[0 * s] - d[7 * s];
+    float tmp1 = d[1 * s] + d[6 * s];
+    float tmp6 = d[1 * s] - d[6 * s];
+    float tmp2 = d[2 * s] + d[5 * s];
+    float tmp5 = d[2 * s] - d[5 * s];
+    float tmp3 = d[3 * s] + d[4 * s];
+    float tmp4 = d[3 * s] - d[4 * s];
+
+    // Even part
+    float tmp10 = tmp0 + tmp3;
+    float tmp13 = tmp0 - tmp3;
+    float tmp11 = tmp1 + tmp2;
+    float tmp12 = tmp1 - tmp2;
+
+    d[0 * s] = tmp10 + tmp11;
+    d[4 * s] = tmp10 - tmp11;
+
+    float z1 = (tmp12 + tmp13) * 0.707106781f;
+    d[2 * s] = tmp13 + z1;
+    d[6 * s] = tmp13 - z1;
+
+    // Odd part
+    tmp10 = tmp4 + tmp5;
+    tmp11 = tmp5 + tmp6;
+    tmp12 = tmp6 + tmp7;
+
+    float z5 = (tmp10 - tmp12) * 0.382683433f;
+    float z2 = 0.541196100f * tmp10 + z5;
+    float z4 = 1.306562965f * tmp12 + z5;
+    float z3 = tmp11 * 0.707106781f;
+
+    float z11 = tmp7 + z3;
+    float z13 = tmp7 - z3;
+
+    d[5 * s] = z13 + z2;
+    d[3 * s] = z13 - z2;
+    d[1 * s] = z11 + z4;
+    d[7 * s] = z11 - z4;
+}
+
+// -------------------------
+// 1-D AAN inverse (unscaled)
+// -------------------------
+static inline void aan_idct_1d(float* d, uint32_t s) {
+    // Even part
+    float tmp0 = d[0 * s];
+    float tmp1 = d[2 * s];
+    float tmp2 = d[4 * s];
+    float tmp3 = d[6 * s];
+
+    float tmp10 = tmp0 + tmp2;
+    float tmp11 = tmp0 - tmp2;
+    float tmp13 = tmp1 + tmp3;
+    float tmp12 = (tmp1 - tmp3) * 1.414213562f - tmp13;
+
+    tmp0 = tmp10 + tmp13;
+    tmp3 = tmp10 - tmp13;
+    tmp1 = tmp11 + tmp12;
+    tmp2 = tmp11 - tmp12;
+
+    // Odd part
+    float tmp4 = d[1 * s];
+    float tmp5 = d[3 * s];
+    float tmp6 = d[5 * s];
+    float tmp7 = d[7 * s];
+
+    float z13 = tmp6 + tmp5;
+    float z10 = tmp6 - tmp5;
+    float z11 = tmp4 + tmp7;
+    float z12 = tmp4 - tmp7;
+
+    tmp7 = z11 + z13;
+    tmp11 = (z11 - z13) * 1.414213562f;
+
+    float z5 = (z10 + z12) * 1.847759065f;
+    tmp10 = 1.082392200f * z12 - z5;
+    tmp12 = -2.613125930f * z10 + z5;
+
+    tmp6 = tmp12 - tmp7;
+    tmp5 = tmp11 - tmp6;
+    tmp4 = tmp10 + tmp5;
+
+    d[0 * s] = tmp0 + tmp7;
+    d[7 * s] = tmp0 - tmp7;
+    d[1 * s] = tmp1 + tmp6;
+    d[6 * s] = tmp1 - tmp6;
+    d[2 * s] = tmp2 + tmp5;
+    d[5 * s] = tmp2 - tmp5;
+    d[4 * s] = tmp3 + tmp4;
+    d[3 * s] = tmp3 - tmp4;
+}
+
+// -------------------------
+// Forward DCT (AAN)
+// -------------------------
+void dct8x8(const float* input, float* output) {
+    float tmp[64];
+    for (int i = 0; i < 64; ++i)
+        tmp[i] = input[i];
+
+    for (uint32_t r = 0; r < 8; ++r)
+        aan_fdct_1d(tmp + r * 8, 1);
+    for (uint32_t c = 0; c < 8; ++c)
+        aan_fdct_1d(tmp + c, 8);
+
+    for (int i = 0; i < 64; ++i)
+        output[i] = tmp[i] * AAN_FDCT_SCALE.v[i];
+}
+
+// -------------------------
+// Inverse DCT (AAN)
+// -------------------------
+void idct8x8(const float* input, float* output) {
+    float tmp[64];
+    for (int i = 0; i < 64; ++i)
+        tmp[i] = input[i] * AAN_IDCT_SCALE.v[i];
+
+    for (uint32_t c = 0; c < 8; ++c)
+        aan_idct_1d(tmp + c, 8);
+    for (uint32_t r = 0; r < 8; ++r)
+        aan_idct_1d(tmp + r * 8, 1);
+
+    for (int i = 0; i < 64; ++i)
+        output[i] = tmp[i];
+}
+
+// -------------------------
+// Separable forward DCT
+// -------------------------
+void dct8x8_separable(const float* input, float* output) {
+    float tmp[64];
+
+    // Rows: tmp[x][v] = sum_y in[x][y] * B[v][y]
+    for (int x = 0; x < 8; ++x) {
+        for (int v = 0; v < 8; ++v) {
+            float sum = 0.0f;
+            for (int y = 0; y < 8; ++y)
+                sum += input[x * 8 + y] * DCT8_BASIS[v][y];
+            tmp[x * 8 + v] = sum;
+        }
+    }
+
+    // Columns: out[u][v] = sum_x B[u][x] * tmp[x][v]
+    for (int u = 0; u < 8; ++u) {
+        for (int v = 0; v < 8; ++v) {
+            float sum = 0.0f;
+            for (int x = 0; x < 8; ++x)
+                sum += DCT8_BASIS[u][x] * tmp[x * 8 + v];
+            output[u * 8 + v] = sum;
+        }
+    }
+}
+
+// -------------------------
+// Separable inverse DCT
+// -------------------------
+void idct8x8_separable(const float* input, float* output) {
+    float tmp[64];
+
+    // Rows: tmp[u][y] = sum_v in[u][v] * B[v][y]
+    for (int u = 0; u < 8; ++u) {
+        for (int y = 0; y < 8; ++y) {
+            float sum = 0.0f;
+            for (int v = 0; v < 8; ++v)
+                sum += input[u * 8 + v] * DCT8_BASIS[v][y];
+            tmp[u * 8 + y] = sum;
+        }
+    }
+
+    // Columns: out[x][y] = sum_u B[u][x] * tmp[u][y]
+    for (int x = 0; x < 8; ++x) {
+        for (int y = 0; y < 8; ++y) {
+            float sum = 0.0f;
+            for (int u = 0; u < 8; ++u)
+                sum += DCT8_BASIS[u][x] * tmp[u * 8 + y];
+            output[x * 8 + y] = sum;
+        }
+    }
+}
+
+// -------------------------
+// Forward DCT (reference)
+// -------------------------
+void dct8x8_reference(const float* input, float* output) {
     for (int u = 0; u < 8; ++u) {
         for (int v = 0; v < 8; ++v) {
             float sum = 0.0f;
@@ -33,9 +219,9 @@ void    dct8x8(const float* input, float* output) {
 }
 
 // -------------------------
-// Inverse DCT
+// Inverse DCT (reference)
 // -------------------------
-void idct8x8(const float* input, float* output) {
+void idct8x8_reference(const float* input, float* output) {
     for (int x = 0; x < 8; ++x) {
         for (int y = 0; y < 8; ++y) {
             float sum = 0.0f;
@@ -0,0 +1,147 @@
+#include "wm/transform/dct_basis.h"
+#include "wm/transform/dct_table.h"
+
+#include <cassert>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define WM_BASIS_SSE2 1
+#include <emmintrin.h>
+#else
+#define WM_BASIS_SSE2 0
+#endif
+
+namespace wm {
+
+void build_mask_basis(const DCTIndex* mask, uint32_t count, MaskBasis& out) {
+    assert(count <= DCT_BASIS_MAX);
+
+    out.count = count;
+    out.row_count = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        const uint8_t u = mask[i].u;
+        const uint8_t v = mask[i].v;
+
+        out.index[i] = mask[i];
+        for (uint32_t x = 0; x < 8; ++x)
+            for (uint32_t y = 0; y < 8; ++y)
+                out.vectors[i][x * 8 + y] = DCT8_BASIS[u][x] * DCT8_BASIS[v][y];
+
+        uint32_t slot = 0;
+        while (slot < out.row_count && out.row_freq[slot] != u)
+            ++slot;
+        if (slot == out.row_count)
+            out.row_freq[out.row_count++] = u;
+        out.row_of[i] = uint8_t(slot);
+    }
+}
+
+static MaskBasis make_mid_freq_basis() {
+    MaskBasis b;
+    build_mask_basis(DCT_MID_FREQ_MASK, DCT_MASK_SIZE, b);
+    return b;
+}
+
+const MaskBasis& mid_freq_basis() {
+    static const MaskBasis basis = make_mid_freq_basis();
+    return basis;
+}
+
+void build_sign_patterns(const MaskBasis& basis, SignPatterns& out) {
+    assert(basis.count <= SIGN_PATTERN_MAX_BITS);
+
+    const uint32_t n = 1u << basis.count;
+    out.count = basis.count;
+    out.patterns.assign(size_t(n) * 64, 0.0f);
+
+    for (uint32_t m = 0; m < n; ++m) {
+        float* pat = &out.patterns[size_t(m) * 64];
+        for (uint32_t i = 0; i < basis.count; ++i) {
+            const float s = ((m >> i) & 1u) ? 1.0f : -1.0f;
+            for (uint32_t k = 0; k < 64; ++k)
+                pat[k] += s * basis.vectors[i][k];
+        }
+    }
+}
+
+static SignPatterns make_mid_freq_sign_patterns() {
+    SignPatterns p;
+    build_sign_patterns(mid_freq_basis(), p);
+    return p;
+}
+
+const SignPatterns& mid_freq_sign_patterns() {
+    static const SignPatterns patterns = make_mid_freq_sign_patterns();
+    return patterns;
+}
+
+void analyze_masked(
+    const float* spatial_block,
+    uint32_t stride,
+    const MaskBasis& basis,
+    float* coeff_out
+) {
+#if WM_BASIS_SSE2
+    // SSE2 is part of the x86-64 baseline, so no dispatch is needed
+    __m128 lo[8], hi[8];
+    for (uint32_t x = 0; x < 8; ++x) {
+        lo[x] = _mm_loadu_ps(spatial_block + x * stride);
+        hi[x] = _mm_loadu_ps(spatial_block + x * stride + 4);
+    }
+
+    // R_j[y] = sum_x B[u_j][x] * X[x][y]
+    __m128 r_lo[8], r_hi[8];
+    for (uint32_t j = 0; j < basis.row_count; ++j) {
+        const float* b = DCT8_BASIS[basis.row_freq[j]];
+
+        __m128 acc_lo = _mm_setzero_ps();
+        __m128 acc_hi = _mm_setzero_ps();
+        for (uint32_t x = 0; x < 8; ++x) {
+            __m128 w = _mm_set1_ps(b[x]);
+            acc_lo = _mm_add_ps(acc_lo, _mm_mul_ps(w, lo[x]));
+            acc_hi = _mm_add_ps(acc_hi, _mm_mul_ps(w, hi[x]));
+        }
+        r_lo[j] = acc_lo;
+        r_hi[j] = acc_hi;
+    }
+
+    // coeff_i = sum_y R_j[y] * B[v_i][y]
+    for (uint32_t i = 0; i < basis.count; ++i) {
+        const float* b = DCT8_BASIS[basis.index[i].v];
+        const uint32_t j = basis.row_of[i];
+
+        __m128 s = _mm_add_ps(_mm_mul_ps(r_lo[j], _mm_loadu_ps(b)),
+                              _mm_mul_ps(r_hi[j], _mm_loadu_ps(b + 4)));
+        s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+        s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 1));
+        coeff_out[i] = _mm_cvtss_f32(s);
+    }
+#else
+    // Same grouping and reduction order as the SSE2 path
+    float r[8][8];
+    for (uint32_t j = 0; j < basis.row_count; ++j) {
+        const float* b = DCT8_BASIS[basis.row_freq[j]];
+
+        for (uint32_t y = 0; y < 8; ++y)
+            r[j][y] = 0.0f;
+        for (uint32_t x = 0; x < 8; ++x) {
+            const float* row = spatial_block + x * stride;
+            for (uint32_t y = 0; y < 8; ++y)
+                r[j][y] += b[x] * row[y];
+        }
+    }
+
+    for (uint32_t i = 0; i < basis.count; ++i) {
+        const float* b = DCT8_BASIS[basis.index[i].v];
+        const float* rj = r[basis.row_of[i]];
+
+        float p[8];
+        for (uint32_t y = 0; y < 8; ++y)
+            p[y] = rj[y] * b[y];
+
+        coeff_out[i] = ((p[0] + p[4]) + (p[2] + p[6])) +
+                       ((p[1] + p[5]) + (p[3] + p[7]));
+    }
+#endif
+}
+
+} // namespace wm
@@ -1,5 +1,5 @@
 #include "wm/transform/dwt.h"
-#include <cmath>
+#include <cstring>
 #include <vector>
 #include <cassert>
 
@@ -7,72 +7,139 @@ namespace wm {
 
 static constexpr float INV_SQRT2 = 0.7071067811865475f;
 
+// Adjacent columns processed together by the column passes. Each row
+// segment is 128 bytes, so loads stay contiguous and vectorizable.
+static constexpr uint32_t STRIP = 32;
+
+size_t dwt_scratch_size(uint32_t width, uint32_t height) {
+    size_t rows = size_t(width);
+    size_t cols = size_t(STRIP) * (height / 2);
+    return rows > cols ? rows : cols;
+}
+
 // --------------------------------
-// 1D Haar forward 
+// Forward rows: [a b a b ...] -> [L ... | H ...]
 // --------------------------------
-static void haar_1d(float* data, uint32_t n) {
-    assert(n % 2 == 0);
+static void haar_rows(float* data, uint32_t stride,
+                      uint32_t w, uint32_t h, float* tmp)
+{
+    const uint32_t half = w / 2;
 
-    std::vector<float> temp(n);
+    for (uint32_t y = 0; y < h; ++y) {
+        float* row = data + size_t(y) * stride;
+
+        for (uint32_t i = 0; i < half; ++i) {
+            float a = row[2 * i];
+            float b = row[2 * i + 1];
+            tmp[i]        = (a + b) * INV_SQRT2;
+            tmp[i + half] = (a - b) * INV_SQRT2;
+        }
 
-    uint32_t half = n / 2;
-    for (uint32_t i = 0; i < half; ++i) {
-        float a = data[2 * i];
-        float b = data[2 * i + 1];
-        temp[i]       = (a + b) * INV_SQRT2;
-        temp[i + half]= (a - b) * INV_SQRT2;
+        std::memcpy(row, tmp, sizeof(float) * w);
     }
+}
+
+// --------------------------------
+// Forward columns, one strip at a time
+// --------------------------------
+// Low outputs go straight to row j (its old content was consumed by an
+// earlier j); high outputs are staged in tmp until the strip is done.
+static void haar_cols(float* data, uint32_t stride,
+                      uint32_t w, uint32_t h, float* tmp)
+{
+    const uint32_t half = h / 2;
+
+    for (uint32_t x0 = 0; x0 < w; x0 += STRIP) {
+        const uint32_t n = (w - x0 < STRIP) ? (w - x0) : STRIP;
 
-    for (uint32_t i = 0; i < n; ++i)
-        data[i] = temp[i];
+        for (uint32_t j = 0; j < half; ++j) {
+            const float* r0 = data + size_t(2 * j) * stride + x0;
+            const float* r1 = r0 + stride;
+            float* lo = data + size_t(j) * stride + x0;
+            float* hi = tmp + size_t(j) * STRIP;
+
+            for (uint32_t i = 0; i < n; ++i) {
+                float a = r0[i];
+                float b = r1[i];
+                lo[i] = (a + b) * INV_SQRT2;
+                hi[i] = (a - b) * INV_SQRT2;
+            }
+        }
+
+        for (uint32_t j = 0; j < half; ++j)
+            std::memcpy(data + size_t(half + j) * stride + x0,
+                        tmp + size_t(j) * STRIP,
+                        sizeof(float) * n);
+    }
 }
 
 // --------------------------------
-// 1D Haar inverse
+// Inverse columns, one strip at a time
 // --------------------------------
-static void ihaar_1d(float* data, uint32_t n) {
-    assert(n % 2 == 0);
+// High inputs are staged first; walking j downwards then only overwrites
+// low rows that have already been consumed.
+static void ihaar_cols(float* data, uint32_t stride,
+                       uint32_t w, uint32_t h, float* tmp)
+{
+    const uint32_t half = h / 2;
+
+    for (uint32_t x0 = 0; x0 < w; x0 += STRIP) {
+        const uint32_t n = (w - x0 < STRIP) ? (w - x0) : STRIP;
 
-    std::vector<float> temp(n);
-    uint32_t half = n / 2;
+        for (uint32_t j = 0; j < half; ++j)
+            std::memcpy(tmp + size_t(j) * STRIP,
+                        data + size_t(half + j) * stride + x0,
+                        sizeof(float) * n);
 
-    for (uint32_t i = 0; i < half; ++i) {
-        float a = data[i];
-        float d = data[i + half];
-        temp[2 * i]     = (a + d) * INV_SQRT2;
-        temp[2 * i + 1]= (a - d) * INV_SQRT2;
+        for (uint32_t j = half; j-- > 0;) {
+            const float* lo = data + size_t(j) * stride + x0;
+            const float* hi = tmp + size_t(j) * STRIP;
+            float* r0 = data + size_t(2 * j) * stride + x0;
+            float* r1 = r0 + stride;
+
+            for (uint32_t i = 0; i < n; ++i) {
+                float a = lo[i];
+                float d = hi[i];
+                r0[i] = (a + d) * INV_SQRT2;
+                r1[i] = (a - d) * INV_SQRT2;
+            }
+        }
     }
+}
+
+// --------------------------------
+// Inverse rows: [L ... | H ...] -> [a b a b ...]
+// --------------------------------
+static void ihaar_rows(float* data, uint32_t stride,
+                       uint32_t w, uint32_t h, float* tmp)
+{
+    const uint32_t half = w / 2;
+
+    for (uint32_t y = 0; y < h; ++y) {
+        float* row = data + size_t(y) * stride;
+        std::memcpy(tmp, row, sizeof(float) * w);
 
-    for (uint32_t i = 0; i < n; ++i)
-        data[i] = temp[i];
+        for (uint32_t i = 0; i < half; ++i) {
+            float a = tmp[i];
+            float d = tmp[i + half];
+            row[2 * i]     = (a + d) * INV_SQRT2;
+            row[2 * i + 1] = (a - d) * INV_SQRT2;
+        }
+    }
 }
 
 // --------------------------------
 // 2D Haar DWT (2 levels)
 // --------------------------------
-void dwt2_haar(float* data, uint32_t width, uint32_t height) {
+void dwt2_haar(float* data, uint32_t width, uint32_t height, float* scratch) {
     assert(width % 4 == 0 && height % 4 == 0);
 
     uint32_t w = width;
     uint32_t h = height;
 
     for (int level = 0; level < 2; ++level) {
-
-        // Rows
-        for (uint32_t y = 0; y < h; ++y)
-            haar_1d(&data[y * width], w);
-
-        // Columns
-        std::vector<float> col(h);
-        for (uint32_t x = 0; x < w; ++x) {
-            for (uint32_t y = 0; y < h; ++y)
-                col[y] = data[y * width + x];
-
-            haar_1d(col.data(), h);
-
-            for (uint32_t y = 0; y < h; ++y)
-                data[y * width + x] = col[y];
-        }
+        haar_rows(data, width, w, h, scratch);
+        haar_cols(data, width, w, h, scratch);
 
         w /= 2;
         h /= 2;
@@ -82,36 +149,146 @@ void dwt2_haar(float* data, uint32_t width, uint32_t height) {
 // --------------------------------
 // 2D Haar inverse (2 levels)
 // --------------------------------
-void idwt2_haar(float* data, uint32_t width, uint32_t height) {
+void idwt2_haar(float* data, uint32_t width, uint32_t height, float* scratch) {
     assert(width % 4 == 0 && height % 4 == 0);
 
     // Start from smallest LL band (after 2 levels)
-    uint32_t w = width / 4;
-    uint32_t h = height / 4;
+    uint32_t w = width / 2;
+    uint32_t h = height / 2;
 
     for (int level = 0; level < 2; ++level) {
+        ihaar_cols(data, width, w, h, scratch);
+        ihaar_rows(data, width, w, h, scratch);
 
-        // Inverse columns
-        std::vector<float> col(h * 2);
-        for (uint32_t x = 0; x < w * 2; ++x) {
-            for (uint32_t y = 0; y < h * 2; ++y)
-                col[y] = data[y * width + x];
+        // Expand for next level
+        w *= 2;
+        h *= 2;
+    }
+}
 
-            ihaar_1d(col.data(), h * 2);
+// --------------------------------
+// 32×32 tile, forward
+// --------------------------------
+// The first row pass is fused with the load from the image.
+void dwt2_haar_tile(const float* src, uint32_t stride, float* tile) {
+    constexpr uint32_t N = DWT_TILE;
+    constexpr uint32_t HALF = N / 2;
 
-            for (uint32_t y = 0; y < h * 2; ++y)
-                data[y * width + x] = col[y];
+    float tmp[STRIP * HALF];
+
+    for (uint32_t y = 0; y < N; ++y) {
+        const float* in = src + size_t(y) * stride;
+        float* row = tile + y * N;
+
+        for (uint32_t i = 0; i < HALF; ++i) {
+            float a = in[2 * i];
+            float b = in[2 * i + 1];
+            row[i]        = (a + b) * INV_SQRT2;
+            row[i + HALF] = (a - b) * INV_SQRT2;
         }
+    }
 
-        // Inverse rows
-        for (uint32_t y = 0; y < h * 2; ++y)
-            ihaar_1d(&data[y * width], w * 2);
+    haar_cols(tile, N, N, N, tmp);
+    haar_rows(tile, N, HALF, HALF, tmp);
+    haar_cols(tile, N, HALF, HALF, tmp);
+}
 
-        // Expand for next level
-        w *= 2;
-        h *= 2;
+// --------------------------------
+// 32×32 tile, inverse
+// --------------------------------
+// The last row pass is fused with the store to the image.
+void idwt2_haar_tile(float* tile, float* dst, uint32_t stride) {
+    constexpr uint32_t N = DWT_TILE;
+    constexpr uint32_t HALF = N / 2;
+
+    float tmp[STRIP * HALF];
+
+    ihaar_cols(tile, N, HALF, HALF, tmp);
+    ihaar_rows(tile, N, HALF, HALF, tmp);
+    ihaar_cols(tile, N, N, N, tmp);
+
+    for (uint32_t y = 0; y < N; ++y) {
+        const float* row = tile + y * N;
+        float* out = dst + size_t(y) * stride;
+
+        for (uint32_t i = 0; i < HALF; ++i) {
+            float a = row[i];
+            float d = row[i + HALF];
+            out[2 * i]     = (a + d) * INV_SQRT2;
+            out[2 * i + 1] = (a - d) * INV_SQRT2;
+        }
     }
 }
 
+// --------------------------------
+// Direct level-2 detail subbands
+// --------------------------------
+// With the orthonormal Haar, two levels reduce to ±1/4 weights over a
+// 4×4 neighbourhood:
+//   HL2 = (left two columns  - right two columns) / 4
+//   LH2 = (top two rows      - bottom two rows)   / 4
+static void haar_detail2_strided(const float* data, uint32_t stride,
+                                 uint32_t width, uint32_t height,
+                                 float* hl, float* lh)
+{
+    assert(width % 4 == 0 && height % 4 == 0);
+
+    const uint32_t qw = width / 4;
+    const uint32_t qh = height / 4;
+
+    for (uint32_t j = 0; j < qh; ++j) {
+        const float* r0 = data + size_t(4 * j) * stride;
+        const float* r1 = r0 + stride;
+        const float* r2 = r1 + stride;
+        const float* r3 = r2 + stride;
+
+        float* hl_row = hl + size_t(j) * qw;
+        float* lh_row = lh + size_t(j) * qw;
+
+        for (uint32_t i = 0; i < qw; ++i) {
+            const uint32_t x = 4 * i;
+
+            // Column sums of the top and bottom row pairs
+            float t0 = r0[x]     + r1[x];
+            float t1 = r0[x + 1] + r1[x + 1];
+            float t2 = r0[x + 2] + r1[x + 2];
+            float t3 = r0[x + 3] + r1[x + 3];
+            float b0 = r2[x]     + r3[x];
+            float b1 = r2[x + 1] + r3[x + 1];
+            float b2 = r2[x + 2] + r3[x + 2];
+            float b3 = r2[x + 3] + r3[x + 3];
+
+            float left  = (t0 + t1) + (b0 + b1);
+            float right = (t2 + t3) + (b2 + b3);
+            float top   = (t0 + t1) + (t2 + t3);
+            float bot   = (b0 + b1) + (b2 + b3);
+
+            hl_row[i] = (left - right) * 0.25f;
+            lh_row[i] = (top - bot) * 0.25f;
+        }
+    }
+}
+
+void haar_detail2(const float* data, uint32_t width, uint32_t height,
+                  float* hl, float* lh)
+{
+    haar_detail2_strided(data, width, width, height, hl, lh);
+}
+
+void haar_detail2_tile(const float* src, uint32_t stride,
+                       float* hl, float* lh)
+{
+    haar_detail2_strided(src, stride, DWT_TILE, DWT_TILE, hl, lh);
+}
+
+void dwt2_haar(float* data, uint32_t width, uint32_t height) {
+    std::vector<float> scratch(dwt_scratch_size(width, height));
+    dwt2_haar(data, width, height, scratch.data());
+}
+
+void idwt2_haar(float* data, uint32_t width, uint32_t height) {
+    std::vector<float> scratch(dwt_scratch_size(width, height));
+    idwt2_haar(data, width, height, scratch.data());
+}
 
 } // namespace wm
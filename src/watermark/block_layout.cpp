@@ -0,0 +1,28 @@
+#include "wm/watermark/block_layout.h"
+
+namespace wm {
+
+bool make_block_layout(
+    uint32_t width,
+    uint32_t height,
+    uint32_t payload_len,
+    BlockLayout& out
+) {
+    if (width % 32 != 0 || height % 32 != 0 || payload_len == 0)
+        return false;
+
+    out.blocks_x = width / 32;
+    out.blocks_y = height / 32;
+    out.blocks_per_band = out.blocks_x * out.blocks_y;
+    out.total_blocks = 2 * out.blocks_per_band;
+
+    if (out.total_blocks < payload_len)
+        return false;
+
+    out.blocks_per_bit = out.total_blocks / payload_len;
+    out.used_slots = out.blocks_per_bit * payload_len;
+
+    return true;
+}
+
+} // namespace wm
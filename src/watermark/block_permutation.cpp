@@ -32,4 +32,94 @@ void generate_block_permutation(
     }
 }
 
+void invert_block_permutation(
+    const uint32_t* perm,
+    uint32_t* slot_of_block,
+    uint32_t total_blocks
+) {
+    for (uint32_t s = 0; s < total_blocks; ++s)
+        slot_of_block[perm[s]] = s;
+}
+
+// --------------------------------
+// Feistel permutation
+// --------------------------------
+static inline uint64_t mix64(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+static inline uint32_t feistel_round_fn(uint64_t round_key, uint32_t half) {
+    return static_cast<uint32_t>(mix64(round_key ^ half));
+}
+
+void make_feistel_permutation(
+    uint64_t key,
+    uint32_t n,
+    FeistelPermutation& out
+) {
+    uint32_t bits = 2;
+    while (bits < 32 && (uint64_t(1) << bits) < n)
+        ++bits;
+    if (bits & 1)
+        ++bits;
+
+    out.n = n;
+    out.half_bits = bits / 2;
+
+    // Separate from the v1 shuffle seed so the two never correlate
+    uint64_t seed = key ^ 0x5A5A5A5A5A5A5A5AULL;
+    for (uint64_t& k : out.round_keys)
+        k = splitmix64(seed);
+}
+
+static inline uint32_t feistel_encrypt(const FeistelPermutation& f,
+                                       uint32_t x)
+{
+    const uint32_t mask = (1u << f.half_bits) - 1u;
+    uint32_t l = x >> f.half_bits;
+    uint32_t r = x & mask;
+
+    for (uint64_t k : f.round_keys) {
+        uint32_t t = l ^ (feistel_round_fn(k, r) & mask);
+        l = r;
+        r = t;
+    }
+
+    return (l << f.half_bits) | r;
+}
+
+static inline uint32_t feistel_decrypt(const FeistelPermutation& f,
+                                       uint32_t x)
+{
+    const uint32_t mask = (1u << f.half_bits) - 1u;
+    uint32_t l = x >> f.half_bits;
+    uint32_t r = x & mask;
+
+    for (int i = 3; i >= 0; --i) {
+        uint32_t t = r ^ (feistel_round_fn(f.round_keys[i], l) & mask);
+        r = l;
+        l = t;
+    }
+
+    return (l << f.half_bits) | r;
+}
+
+// Cycle walking: the network permutes [0, 2^bits); re-encrypting until
+// the value lands below n restricts it to a permutation of [0, n)
+uint32_t feistel_permute(const FeistelPermutation& f, uint32_t index) {
+    uint32_t x = feistel_encrypt(f, index);
+    while (x >= f.n)
+        x = feistel_encrypt(f, x);
+    return x;
+}
+
+uint32_t feistel_unpermute(const FeistelPermutation& f, uint32_t block) {
+    uint32_t x = feistel_decrypt(f, block);
+    while (x >= f.n)
+        x = feistel_decrypt(f, x);
+    return x;
+}
+
 }
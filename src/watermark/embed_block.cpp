@@ -1,12 +1,39 @@
 #include "wm/watermark/embed_block.h"
 
+#include "wm/transform/block.h"
 #include "wm/transform/dct.h"
+#include "wm/transform/dct_basis.h"
 #include "wm/transform/dct_mask.h"
 #include "wm/watermark/pn.h"
 
 namespace wm {
 
-void embed_bit_block(
+void embed_bit_coeffs(
+    float* coeff,
+    int8_t bit,
+    uint64_t key,
+    uint32_t bit_index,
+    uint32_t block_index,
+    float alpha
+) {
+    for (uint32_t i = 0; i < DCT_MASK_SIZE; ++i) {
+        uint8_t u = DCT_MID_FREQ_MASK[i].u;
+        uint8_t v = DCT_MID_FREQ_MASK[i].v;
+
+        uint32_t idx = u * 8 + v;
+
+        int8_t pn = pn_chip(
+            key,
+            bit_index,
+            block_index,
+            i        // chip index
+        );
+
+        coeff[idx] += alpha * float(bit) * float(pn);
+    }
+}
+
+void embed_bit_block_transform(
     float* spatial_block,
     uint32_t stride,
     int8_t bit,
@@ -19,9 +46,7 @@ void embed_bit_block(
     // 1. Load spatial block
     // -----------------------------
     float block[64];
-    for (uint32_t y = 0; y < 8; ++y)
-        for (uint32_t x = 0; x < 8; ++x)
-            block[y * 8 + x] = spatial_block[y * stride + x];
+    load_block_8x8(spatial_block, stride, block);
 
     // -----------------------------
     // 2. Forward DCT
@@ -32,21 +57,7 @@ void embed_bit_block(
     // -----------------------------
     // 3. Spread-spectrum embedding
     // -----------------------------
-    for (uint32_t i = 0; i < DCT_MASK_SIZE; ++i) {
-        uint8_t u = DCT_MID_FREQ_MASK[i].u;
-        uint8_t v = DCT_MID_FREQ_MASK[i].v;
-
-        uint32_t idx = u * 8 + v;
-
-        int8_t pn = pn_chip(
-            key,
-            bit_index,
-            block_index,
-            i        // chip index
-        );
-
-        coeff[idx] += alpha * float(bit) * float(pn);
-    }
+    embed_bit_coeffs(coeff, bit, key, bit_index, block_index, alpha);
 
     // -----------------------------
     // 4. Inverse DCT
@@ -57,9 +68,38 @@ void embed_bit_block(
     // -----------------------------
     // 5. Store back
     // -----------------------------
+    store_block_8x8(recon, spatial_block, stride);
+}
+
+void embed_bit_block(
+    float* spatial_block,
+    uint32_t stride,
+    int8_t bit,
+    uint64_t key,
+    uint32_t bit_index,
+    uint32_t block_index,
+    float alpha
+) {
+    embed_mask_block(
+        spatial_block,
+        stride,
+        alpha * float(bit),
+        pn_mask(key, bit_index, block_index)
+    );
+}
+
+void embed_mask_block(
+    float* spatial_block,
+    uint32_t stride,
+    float weight,
+    uint8_t pn_signs
+) {
+    const float* pattern =
+        &mid_freq_sign_patterns().patterns[pn_signs * 64];
+
     for (uint32_t y = 0; y < 8; ++y)
         for (uint32_t x = 0; x < 8; ++x)
-            spatial_block[y * stride + x] = recon[y * 8 + x];
+            spatial_block[y * stride + x] += weight * pattern[y * 8 + x];
 }
 
 } // namespace wm
@@ -1,15 +1,17 @@
 #include "wm/watermark/embed_image.h"
 
+#include "wm/thread_pool.h"
 #include "wm/transform/dwt.h"
 #include "wm/transform/subband.h"
 #include "wm/watermark/block_permutation.h"
 #include "wm/watermark/embed_block.h"
+#include "wm/watermark/embed_tile.h"
 
 #include <vector>
 
 namespace wm {
 
-bool embed_image(
+bool embed_image_reference(
     Image& img,
     const int8_t* payload_bits,
     uint32_t payload_len,
@@ -92,4 +94,77 @@ bool embed_image(
     return true;
 }
 
+bool embed_image(
+    Image& img,
+    const int8_t* payload_bits,
+    uint32_t payload_len,
+    uint64_t key,
+    float alpha,
+    uint32_t threads
+) {
+    Plan plan;
+    if (!build_plan(plan, img.width, img.height, payload_len, key))
+        return false;
+
+    return embed_image(plan, img, payload_bits, alpha, threads);
+}
+
+bool embed_image(
+    const Plan& plan,
+    Image& img,
+    const int8_t* payload_bits,
+    float alpha,
+    uint32_t threads
+) {
+    const uint32_t W = img.width;
+
+    if (W != plan.width || img.height != plan.height)
+        return false;
+
+    // -------------------------
+    // Fused tiles, visited in memory order
+    // -------------------------
+    parallel_for(plan.layout.blocks_y, threads, [&](uint32_t by) {
+        embed_tile_row(
+            img.Y + size_t(by) * 32 * W,
+            W,
+            by,
+            plan,
+            payload_bits,
+            alpha
+        );
+    });
+
+    return true;
+}
+
+bool embed_image_layers(
+    Image& img,
+    const EmbedLayer* layers,
+    uint32_t count,
+    uint32_t threads
+) {
+    const uint32_t W = img.width;
+
+    if (count == 0)
+        return false;
+
+    for (uint32_t l = 0; l < count; ++l)
+        if (layers[l].plan->width != W ||
+            layers[l].plan->height != img.height)
+            return false;
+
+    const uint32_t rows = layers[0].plan->layout.blocks_y;
+
+    // Scratch sized once up front so the row tasks never allocate
+    std::vector<TileBlock> blocks(size_t(rows) * 2 * count);
+
+    parallel_for(rows, threads, [&](uint32_t by) {
+        embed_tile_row(img.Y + size_t(by) * 32 * W, W, by, layers, count,
+                       blocks.data() + size_t(by) * 2 * count);
+    });
+
+    return true;
+}
+
 }
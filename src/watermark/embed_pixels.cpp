@@ -0,0 +1,57 @@
+#include "wm/watermark/embed_pixels.h"
+
+#include "wm/thread_pool.h"
+#include "wm/transform/dwt.h"
+#include "wm/watermark/embed_tile.h"
+
+namespace wm {
+
+bool embed_pixels(
+    const Plan& plan,
+    PixelImage& img,
+    const int8_t* payload_bits,
+    float alpha,
+    uint32_t threads
+) {
+    constexpr uint32_t N = DWT_TILE;
+
+    if (img.width != plan.width || img.height != plan.height)
+        return false;
+
+    const uint32_t bpp = bytes_per_pixel(img.format);
+    if (img.pitch < size_t(img.width) * bpp)
+        return false;
+
+    parallel_for(plan.layout.blocks_y, threads, [&](uint32_t by) {
+        alignas(64) float tile[N * N];
+        alignas(64) float delta[N * N];
+
+        uint8_t* band = img.data + size_t(by) * N * img.pitch;
+
+        for (uint32_t bx = 0; bx < plan.layout.blocks_x; ++bx) {
+            uint8_t* origin = band + size_t(bx) * N * bpp;
+
+            for (uint32_t y = 0; y < N; ++y)
+                luma_row(origin + y * img.pitch, img.format, N,
+                         tile + y * N);
+
+            for (uint32_t i = 0; i < N * N; ++i)
+                delta[i] = tile[i];
+
+            TileBlock blocks[2];
+            tile_blocks(plan, payload_bits, bx, by, blocks);
+            embed_tile(tile, N, blocks, alpha);
+
+            for (uint32_t i = 0; i < N * N; ++i)
+                delta[i] = tile[i] - delta[i];
+
+            for (uint32_t y = 0; y < N; ++y)
+                add_luma_row(origin + y * img.pitch, img.format, N,
+                             delta + y * N);
+        }
+    });
+
+    return true;
+}
+
+} // namespace wm
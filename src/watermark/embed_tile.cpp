@@ -0,0 +1,123 @@
+#include "wm/watermark/embed_tile.h"
+
+#include "wm/transform/dwt.h"
+#include "wm/watermark/embed_block.h"
+
+namespace wm {
+
+void tile_blocks(
+    const Plan& plan,
+    const int8_t* payload_bits,
+    uint32_t bx,
+    uint32_t by,
+    TileBlock out[2]
+) {
+    const BlockLayout& L = plan.layout;
+
+    for (uint32_t b = 0; b < 2; ++b) {
+        uint32_t p = b * L.blocks_per_band + by * L.blocks_x + bx;
+        uint32_t bit = plan_bit_of_block(plan, p);
+
+        out[b].bit_index = bit;
+        out[b].bit = bit != NO_BIT ? payload_bits[bit] : 0;
+        out[b].pn_signs = bit != NO_BIT ? plan_pn_signs(plan, p, bit) : 0;
+    }
+}
+
+// One layer's HL2/LH2 blocks into a transformed tile
+static void embed_tile_blocks(
+    float* tile,
+    const TileBlock blocks[2],
+    float alpha
+) {
+    constexpr uint32_t N = DWT_TILE;
+
+    // HL2 sits right of LL2, LH2 below it (see subband.cpp)
+    float* const band[2] = {
+        tile + N / 4,
+        tile + (N / 4) * N
+    };
+
+    for (int b = 0; b < 2; ++b) {
+        if (blocks[b].bit_index == NO_BIT)
+            continue;
+
+        embed_mask_block(
+            band[b],
+            N,
+            alpha * float(blocks[b].bit),
+            blocks[b].pn_signs
+        );
+    }
+}
+
+void embed_tile(
+    float* pixels,
+    uint32_t stride,
+    const TileBlock blocks[2],
+    float alpha
+) {
+    constexpr uint32_t N = DWT_TILE;
+
+    alignas(64) float tile[N * N];
+    dwt2_haar_tile(pixels, stride, tile);
+    embed_tile_blocks(tile, blocks, alpha);
+    idwt2_haar_tile(tile, pixels, stride);
+}
+
+void embed_tile(
+    float* pixels,
+    uint32_t stride,
+    const TileBlock* blocks,
+    const EmbedLayer* layers,
+    uint32_t count
+) {
+    constexpr uint32_t N = DWT_TILE;
+
+    alignas(64) float tile[N * N];
+    dwt2_haar_tile(pixels, stride, tile);
+
+    for (uint32_t l = 0; l < count; ++l)
+        embed_tile_blocks(tile, &blocks[2 * l], layers[l].alpha);
+
+    idwt2_haar_tile(tile, pixels, stride);
+}
+
+void embed_tile_row(
+    float* band,
+    uint32_t stride,
+    uint32_t by,
+    const Plan& plan,
+    const int8_t* payload_bits,
+    float alpha
+) {
+    TileBlock blocks[2];
+
+    // Tiles without a payload bit still make the Haar round trip so the
+    // output matches the pass-based embedding bit for bit.
+    for (uint32_t bx = 0; bx < plan.layout.blocks_x; ++bx) {
+        tile_blocks(plan, payload_bits, bx, by, blocks);
+        embed_tile(band + bx * DWT_TILE, stride, blocks, alpha);
+    }
+}
+
+void embed_tile_row(
+    float* band,
+    uint32_t stride,
+    uint32_t by,
+    const EmbedLayer* layers,
+    uint32_t count,
+    TileBlock* blocks
+) {
+    const BlockLayout& L = layers[0].plan->layout;
+
+    for (uint32_t bx = 0; bx < L.blocks_x; ++bx) {
+        for (uint32_t l = 0; l < count; ++l)
+            tile_blocks(*layers[l].plan, layers[l].payload_bits, bx, by,
+                        &blocks[2 * l]);
+
+        embed_tile(band + bx * DWT_TILE, stride, blocks, layers, count);
+    }
+}
+
+} // namespace wm
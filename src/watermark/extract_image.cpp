@@ -1,9 +1,10 @@
 #include "wm/watermark/extract_image.h"
 
+#include "wm/thread_pool.h"
+#include "wm/transform/dct_basis.h"
 #include "wm/transform/dwt.h"
-#include "wm/transform/subband.h"
-#include "wm/watermark/block_permutation.h"
 #include "wm/watermark/extract_block.h"
+#include "wm/watermark/tile_templates.h"
 
 #include <vector>
 #include <cmath>
@@ -11,91 +12,224 @@
 namespace wm {
 
 bool extract_image(
-    Image& img,
+    const Image& img,
     int8_t* bits_out,
     float* confidence_out,
     uint32_t payload_len,
-    uint64_t key
+    uint64_t key,
+    uint32_t threads
 ) {
-    const uint32_t W = img.width;
-    const uint32_t H = img.height;
-
-    // -------------------------
-    // Validate dimensions
-    // -------------------------
-    if (W % 32 != 0 || H % 32 != 0)
+    Plan plan;
+    if (!build_plan(plan, img.width, img.height, payload_len, key))
         return false;
 
-    // -------------------------
-    // Forward DWT
-    // -------------------------
-    dwt2_haar(img.Y, W, H);
+    return extract_image(plan, img, bits_out, confidence_out, threads);
+}
 
-    // -------------------------
-    // Subbands
-    // -------------------------
-    SubbandView hl = HL2(img.Y, W, H);
-    SubbandView lh = LH2(img.Y, W, H);
+// --------------------------------
+// Block correlations, one tile row
+// --------------------------------
+// Transform domain: each tile's 8×8 HL2/LH2 blocks, computed straight
+// from the pixels into a stack buffer, then masked DCT analysis and PN
+// correlation per block.
+static void correlate_row_transform(
+    const Plan& plan,
+    const Image& img,
+    uint32_t by,
+    float* corr_out
+) {
+    const BlockLayout& L = plan.layout;
+    const MaskBasis& basis = mid_freq_basis();
+    const float* band = img.Y + size_t(by) * DWT_TILE * img.width;
+
+    for (uint32_t bx = 0; bx < L.blocks_x; ++bx) {
+        uint32_t p[2], bit[2];
+        for (uint32_t b = 0; b < 2; ++b) {
+            p[b] = b * L.blocks_per_band + by * L.blocks_x + bx;
+            bit[b] = plan_bit_of_block(plan, p[b]);
+        }
+
+        if (bit[0] == NO_BIT && bit[1] == NO_BIT) {
+            corr_out[p[0]] = corr_out[p[1]] = 0.0f;
+            continue;
+        }
 
-    const uint32_t blocks_x = W / 32;
-    const uint32_t blocks_y = H / 32;
-    const uint32_t blocks_per_band = blocks_x * blocks_y;
-    const uint32_t total_blocks = 2 * blocks_per_band;
+        float detail[2][8 * 8];
+        haar_detail2_tile(band + bx * DWT_TILE, img.width,
+                          detail[0], detail[1]);
 
-    if (total_blocks < payload_len)
+        for (uint32_t b = 0; b < 2; ++b) {
+            if (bit[b] == NO_BIT) {
+                corr_out[p[b]] = 0.0f;
+                continue;
+            }
+
+            // Only the masked coefficients are needed for correlation
+            float coeff[DCT_MASK_SIZE];
+            analyze_masked(detail[b], 8, basis, coeff);
+
+            corr_out[p[b]] = correlate_mask_coeffs(
+                coeff, plan_pn_signs(plan, p[b], bit[b]));
+        }
+    }
+}
+
+// Matched filter: each tile's pixels against the templates of its two
+// blocks, no transform at all
+static void correlate_row_matched(
+    const Plan& plan,
+    const Image& img,
+    uint32_t by,
+    float* corr_out
+) {
+    const BlockLayout& L = plan.layout;
+    const TileTemplates& t = mid_freq_tile_templates();
+    const float* band = img.Y + size_t(by) * 32 * img.width;
+
+    for (uint32_t bx = 0; bx < L.blocks_x; ++bx) {
+        uint32_t p[2], bit[2];
+        const float* q[2];
+
+        for (uint32_t b = 0; b < 2; ++b) {
+            p[b] = b * L.blocks_per_band + by * L.blocks_x + bx;
+            bit[b] = plan_bit_of_block(plan, p[b]);
+            q[b] = t.at(b, bit[b] != NO_BIT
+                               ? plan_pn_signs(plan, p[b], bit[b])
+                               : 0);
+        }
+
+        float c[2] = { 0.0f, 0.0f };
+        if (bit[0] != NO_BIT || bit[1] != NO_BIT)
+            correlate_tile(band + bx * 32, img.width, q[0], q[1],
+                           &c[0], &c[1]);
+
+        // Blocks without a bit report 0, as in the transform domain
+        for (uint32_t b = 0; b < 2; ++b)
+            corr_out[p[b]] = bit[b] != NO_BIT ? c[b] : 0.0f;
+    }
+}
+
+bool block_correlations(
+    const Plan& plan,
+    const Image& img,
+    float* corr_out,
+    ExtractMode mode,
+    uint32_t threads
+) {
+    if (img.width != plan.width || img.height != plan.height)
         return false;
 
-    const uint32_t blocks_per_bit = total_blocks / payload_len;
+    // One tile row per task; rows write disjoint blocks
+    parallel_for(plan.layout.blocks_y, threads, [&](uint32_t by) {
+        if (mode == ExtractMode::MatchedFilter)
+            correlate_row_matched(plan, img, by, corr_out);
+        else
+            correlate_row_transform(plan, img, by, corr_out);
+    });
 
-    // -------------------------
-    // Block permutation
-    // -------------------------
-    std::vector<uint32_t> perm(total_blocks);
-    generate_block_permutation(key, perm.data(), total_blocks);
+    return true;
+}
+
+bool extract_image(
+    const Plan& plan,
+    const Image& img,
+    int8_t* bits_out,
+    float* confidence_out,
+    uint32_t threads,
+    ExtractMode mode
+) {
+    const BlockLayout& L = plan.layout;
 
     // -------------------------
-    // Extract payload
+    // Correlations, in memory order
     // -------------------------
-    for (uint32_t bit = 0; bit < payload_len; ++bit) {
-        int32_t sum = 0;
+    // Blocks are visited row by row across each subband, one 32-row band
+    // per task, so the pixels are streamed once. The caller's buffer is
+    // only read, so several verifications may share it.
+    std::vector<float> corr(L.total_blocks);
 
-        for (uint32_t k = 0; k < blocks_per_bit; ++k) {
-            uint32_t p = perm[bit * blocks_per_bit + k];
-
-            bool is_lh = (p >= blocks_per_band);
-            uint32_t local = is_lh ? (p - blocks_per_band) : p;
+    if (!block_correlations(plan, img, corr.data(), mode, threads))
+        return false;
 
-            uint32_t by = local / blocks_x;
-            uint32_t bx = local % blocks_x;
+    votes_to_bits(plan, corr.data(), bits_out, confidence_out);
+    return true;
+}
 
-            SubbandView& band = is_lh ? lh : hl;
+void votes_to_bits(
+    const Plan& plan,
+    const float* corr,
+    int8_t* bits_out,
+    float* confidence_out
+) {
+    const BlockLayout& L = plan.layout;
 
-            const float* block_ptr =
-                band.data +
-                by * 8 * band.stride +
-                bx * 8;
+    // The inverse permutation sends each block to its bit. Votes are
+    // integers, so the result is identical for any thread count.
+    std::vector<int32_t> sums(plan.payload_len, 0);
 
-            int8_t vote = extract_bit_block(
-                block_ptr,
-                band.stride,
-                key,
-                bit,
-                p
-            );
+    for (uint32_t p = 0; p < L.total_blocks; ++p) {
+        uint32_t bit = plan_bit_of_block(plan, p);
+        if (bit != NO_BIT)
+            sums[bit] += (corr[p] >= 0.0f) ? +1 : -1;
+    }
 
-            sum += vote;
-        }
+    for (uint32_t bit = 0; bit < plan.payload_len; ++bit) {
+        int32_t sum = sums[bit];
 
         bits_out[bit] = (sum >= 0) ? +1 : -1;
         confidence_out[bit] =
             std::fabs(static_cast<float>(sum)) /
-            static_cast<float>(blocks_per_bit);
+            static_cast<float>(L.blocks_per_bit);
     }
+}
 
-    // -------------------------
-    // Inverse DWT
-    // -------------------------
-    idwt2_haar(img.Y, W, H);
+// --------------------------------
+// Soft decisions
+// --------------------------------
+void soft_scores(const Plan& plan, const float* corr, float* score_out) {
+    const BlockLayout& L = plan.layout;
+
+    std::vector<double> sum(plan.payload_len, 0.0);
+    std::vector<double> energy(plan.payload_len, 0.0);
+
+    // Memory order, one thread: the same sums for any thread count
+    for (uint32_t p = 0; p < L.total_blocks; ++p) {
+        uint32_t bit = plan_bit_of_block(plan, p);
+        if (bit == NO_BIT)
+            continue;
+
+        sum[bit] += corr[p];
+        energy[bit] += double(corr[p]) * corr[p];
+    }
+
+    for (uint32_t bit = 0; bit < plan.payload_len; ++bit)
+        score_out[bit] = energy[bit] > 0.0
+                             ? float(sum[bit] / std::sqrt(energy[bit]))
+                             : 0.0f;
+}
+
+bool extract_image_soft(
+    const Plan& plan,
+    const Image& img,
+    int8_t* bits_out,
+    float* confidence_out,
+    float* score_out,
+    uint32_t threads,
+    ExtractMode mode
+) {
+    std::vector<float> corr(plan.layout.total_blocks);
+
+    if (!block_correlations(plan, img, corr.data(), mode, threads))
+        return false;
+
+    soft_scores(plan, corr.data(), score_out);
+
+    for (uint32_t bit = 0; bit < plan.payload_len; ++bit) {
+        float z = score_out[bit];
+
+        bits_out[bit] = (z >= 0.0f) ? +1 : -1;
+        confidence_out[bit] = std::erf(std::fabs(z) * 0.70710678f);
+    }
 
     return true;
 }
@@ -0,0 +1,73 @@
+#include "wm/watermark/fanout.h"
+
+#include "wm/thread_pool.h"
+
+namespace wm {
+
+// --------------------------------
+// Synthesis
+// --------------------------------
+void fanout_tile_row(
+    const float* src_band,
+    float* dst_band,
+    uint32_t stride,
+    uint32_t by,
+    const Plan& plan,
+    const int8_t* payload_bits,
+    float alpha
+) {
+    constexpr uint32_t N = DWT_TILE;
+
+    const BlockLayout& L = plan.layout;
+    const TileTemplates& t = mid_freq_tile_templates();
+
+    for (uint32_t bx = 0; bx < L.blocks_x; ++bx) {
+        float w[2];
+        const float* q[2];
+
+        for (uint32_t b = 0; b < 2; ++b) {
+            uint32_t p = b * L.blocks_per_band + by * L.blocks_x + bx;
+            uint32_t bit = plan_bit_of_block(plan, p);
+
+            if (bit == NO_BIT) {
+                w[b] = 0.0f;
+                q[b] = t.at(b, 0);
+            } else {
+                w[b] = alpha * float(payload_bits[bit]);
+                q[b] = t.at(b, plan_pn_signs(plan, p, bit));
+            }
+        }
+
+        const float* src = src_band + bx * N;
+        float* dst = dst_band + bx * N;
+
+        for (uint32_t y = 0; y < N; ++y) {
+            const float* s = src + size_t(y) * stride;
+            const float* q0 = q[0] + y * N;
+            const float* q1 = q[1] + y * N;
+            float* d = dst + size_t(y) * stride;
+
+            for (uint32_t x = 0; x < N; ++x)
+                d[x] = s[x] + (w[0] * q0[x] + w[1] * q1[x]);
+        }
+    }
+}
+
+void fanout_embed(
+    const Plan& plan,
+    const float* source,
+    const int8_t* payload_bits,
+    float alpha,
+    float* dst,
+    uint32_t threads
+) {
+    const uint32_t W = plan.width;
+
+    parallel_for(plan.layout.blocks_y, threads, [&](uint32_t by) {
+        size_t offset = size_t(by) * DWT_TILE * W;
+        fanout_tile_row(source + offset, dst + offset, W, by, plan,
+                        payload_bits, alpha);
+    });
+}
+
+} // namespace wm
@@ -0,0 +1,160 @@
+#include "wm/watermark/feature_file.h"
+
+#include "wm/transform/dct_mask.h"
+#include "wm/watermark/features.h"
+
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define WM_HAVE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define WM_HAVE_MMAP 0
+#endif
+
+namespace wm {
+
+size_t feature_file_size(uint32_t width, uint32_t height) {
+    return sizeof(FeatureFileHeader) +
+           feature_count(width, height) * sizeof(float);
+}
+
+FeatureFileHeader make_feature_header(uint32_t width, uint32_t height) {
+    FeatureFileHeader h;
+    std::memset(&h, 0, sizeof h);
+
+    std::memcpy(h.magic, FEATURE_FILE_MAGIC, sizeof h.magic);
+    h.version = FEATURE_FILE_VERSION;
+    h.byte_order = FEATURE_FILE_BYTE_ORDER;
+    h.header_size = sizeof(FeatureFileHeader);
+    h.width = width;
+    h.height = height;
+    h.block_count = (width / 32) * (height / 32) * 2;
+    h.coeffs_per_block = DCT_MASK_SIZE;
+
+    return h;
+}
+
+bool parse_feature_file(
+    const void* data,
+    size_t size,
+    uint32_t& width,
+    uint32_t& height,
+    const float*& features
+) {
+    if (!data || size < sizeof(FeatureFileHeader))
+        return false;
+
+    FeatureFileHeader h;
+    std::memcpy(&h, data, sizeof h);
+
+    if (std::memcmp(h.magic, FEATURE_FILE_MAGIC, sizeof h.magic) != 0 ||
+        h.version != FEATURE_FILE_VERSION ||
+        h.byte_order != FEATURE_FILE_BYTE_ORDER ||
+        h.header_size != sizeof(FeatureFileHeader) ||
+        h.coeffs_per_block != DCT_MASK_SIZE)
+        return false;
+
+    if (h.width == 0 || h.height == 0 ||
+        h.width % 32 != 0 || h.height % 32 != 0 ||
+        h.block_count != (h.width / 32) * (h.height / 32) * 2 ||
+        size != feature_file_size(h.width, h.height))
+        return false;
+
+    // The features are read as floats in place
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    if (reinterpret_cast<uintptr_t>(bytes + h.header_size) %
+            alignof(float) != 0)
+        return false;
+
+    width = h.width;
+    height = h.height;
+    features = reinterpret_cast<const float*>(bytes + h.header_size);
+
+    return true;
+}
+
+// --------------------------------
+// File helpers
+// --------------------------------
+bool write_file(const char* path, const void* data, size_t size) {
+    std::FILE* f = std::fopen(path, "wb");
+    if (!f)
+        return false;
+
+    bool ok = std::fwrite(data, 1, size, f) == size;
+    ok = (std::fclose(f) == 0) && ok;
+
+    return ok;
+}
+
+bool map_file(const char* path, MappedFile& out) {
+    out = MappedFile{};
+
+#if WM_HAVE_MMAP
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size <= 0) {
+        ::close(fd);
+        return false;
+    }
+
+    void* p = ::mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_PRIVATE,
+                     fd, 0);
+    ::close(fd);
+
+    if (p == MAP_FAILED)
+        return false;
+
+    out.data = p;
+    out.size = size_t(st.st_size);
+    out.mapped = true;
+    return true;
+#else
+    std::FILE* f = std::fopen(path, "rb");
+    if (!f)
+        return false;
+
+    bool ok = std::fseek(f, 0, SEEK_END) == 0;
+    long size = ok ? std::ftell(f) : -1;
+    ok = ok && size > 0 && std::fseek(f, 0, SEEK_SET) == 0;
+
+    void* p = ok ? ::operator new(size_t(size), std::nothrow) : nullptr;
+    ok = p && std::fread(p, 1, size_t(size), f) == size_t(size);
+    std::fclose(f);
+
+    if (!ok) {
+        ::operator delete(p);
+        return false;
+    }
+
+    out.data = p;
+    out.size = size_t(size);
+    return true;
+#endif
+}
+
+void unmap_file(MappedFile& file) {
+    if (!file.data)
+        return;
+
+#if WM_HAVE_MMAP
+    if (file.mapped)
+        ::munmap(const_cast<void*>(file.data), file.size);
+#endif
+    if (!file.mapped)
+        ::operator delete(const_cast<void*>(file.data));
+
+    file = MappedFile{};
+}
+
+} // namespace wm
@@ -0,0 +1,91 @@
+#include "wm/watermark/features.h"
+
+#include "wm/thread_pool.h"
+#include "wm/transform/dct_basis.h"
+#include "wm/transform/dwt.h"
+#include "wm/watermark/extract_image.h"
+
+#include <cstring>
+#include <vector>
+
+namespace wm {
+
+size_t feature_count(uint32_t width, uint32_t height) {
+    return size_t(width / 32) * (height / 32) * 2 * DCT_MASK_SIZE;
+}
+
+bool compute_features(const Image& img, float* features_out,
+                      uint32_t threads) {
+    const uint32_t W = img.width;
+    const uint32_t H = img.height;
+
+    if (W == 0 || H == 0 || W % 32 != 0 || H % 32 != 0)
+        return false;
+
+    const uint32_t blocks_x = W / 32;
+    const uint32_t blocks_y = H / 32;
+    const MaskBasis& basis = mid_freq_basis();
+
+    // Same per-tile detail blocks and analysis as extract_image
+    parallel_for(blocks_y, threads, [&](uint32_t by) {
+        const float* band = img.Y + size_t(by) * DWT_TILE * W;
+
+        for (uint32_t bx = 0; bx < blocks_x; ++bx) {
+            float detail[2][8 * 8];
+            haar_detail2_tile(band + bx * DWT_TILE, W, detail[0], detail[1]);
+
+            for (uint32_t b = 0; b < 2; ++b) {
+                size_t p = (size_t(b) * blocks_y + by) * blocks_x + bx;
+                analyze_masked(detail[b], 8, basis,
+                               features_out + p * DCT_MASK_SIZE);
+            }
+        }
+    });
+
+    return true;
+}
+
+void feature_correlations(const Plan& plan, const float* features,
+                          float* corr_out) {
+    // correlate_mask_coeffs inlined: with the features in hand this loop
+    // is most of the per-key cost. Multiplying by ±1 only sets the sign,
+    // so flipping the sign bit and summing in mask order gives the same
+    // result without a branch or a multiply.
+    for (uint32_t p = 0; p < plan.layout.total_blocks; ++p) {
+        uint32_t bit = plan_bit_of_block(plan, p);
+        if (bit == NO_BIT) {
+            corr_out[p] = 0.0f;
+            continue;
+        }
+
+        const float* f = features + size_t(p) * DCT_MASK_SIZE;
+        const uint32_t signs = plan_pn_signs(plan, p, bit);
+
+        float sum = 0.0f;
+        for (uint32_t i = 0; i < DCT_MASK_SIZE; ++i) {
+            uint32_t u;
+            std::memcpy(&u, &f[i], sizeof u);
+            u ^= (~signs >> i & 1u) << 31;
+
+            float v;
+            std::memcpy(&v, &u, sizeof v);
+            sum += v;
+        }
+
+        corr_out[p] = sum;
+    }
+}
+
+void extract_features(
+    const Plan& plan,
+    const float* features,
+    int8_t* bits_out,
+    float* confidence_out
+) {
+    std::vector<float> corr(plan.layout.total_blocks);
+
+    feature_correlations(plan, features, corr.data());
+    votes_to_bits(plan, corr.data(), bits_out, confidence_out);
+}
+
+} // namespace wm
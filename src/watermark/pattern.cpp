@@ -0,0 +1,89 @@
+#include "wm/watermark/pattern.h"
+
+#include "wm/thread_pool.h"
+#include "wm/watermark/embed_image.h"
+
+#include <cmath>
+
+namespace wm {
+
+// Rows handed to one task by apply_pattern
+static constexpr uint32_t PATTERN_ROWS = 32;
+
+bool build_pattern(
+    Pattern& out,
+    const Plan& plan,
+    const int8_t* payload_bits,
+    float alpha,
+    PatternFormat format,
+    uint32_t threads
+) {
+    const size_t n = size_t(plan.width) * plan.height;
+
+    std::vector<float> p(n, 0.0f);
+    Image zero{ plan.width, plan.height, p.data() };
+
+    if (!embed_image(plan, zero, payload_bits, alpha, threads))
+        return false;
+
+    out.width = plan.width;
+    out.height = plan.height;
+    out.format = format;
+    out.scale = 0.0f;
+    out.f32.clear();
+    out.i16.clear();
+
+    if (format == PatternFormat::Float32) {
+        out.f32.swap(p);
+        return true;
+    }
+
+    // -------------------------
+    // Int16: symmetric quantization over the full range
+    // -------------------------
+    float peak = 0.0f;
+    for (float v : p)
+        peak = std::fmax(peak, std::fabs(v));
+
+    out.scale = peak > 0.0f ? peak / 32767.0f : 1.0f;
+    const float inv = 1.0f / out.scale;
+
+    out.i16.resize(n);
+    for (size_t i = 0; i < n; ++i)
+        out.i16[i] = static_cast<int16_t>(std::lrintf(p[i] * inv));
+
+    return true;
+}
+
+bool apply_pattern(const Pattern& pattern, Image& img, uint32_t threads) {
+    if (img.width != pattern.width || img.height != pattern.height)
+        return false;
+
+    const uint32_t W = img.width;
+    const uint32_t H = img.height;
+    const uint32_t tasks = (H + PATTERN_ROWS - 1) / PATTERN_ROWS;
+
+    parallel_for(tasks, threads, [&](uint32_t t) {
+        const uint32_t y0 = t * PATTERN_ROWS;
+        const uint32_t rows = H - y0 < PATTERN_ROWS ? H - y0 : PATTERN_ROWS;
+        const size_t begin = size_t(y0) * W;
+        const size_t count = size_t(rows) * W;
+
+        float* y = img.Y + begin;
+
+        if (pattern.format == PatternFormat::Float32) {
+            const float* p = pattern.f32.data() + begin;
+            for (size_t i = 0; i < count; ++i)
+                y[i] += p[i];
+        } else {
+            const int16_t* q = pattern.i16.data() + begin;
+            const float scale = pattern.scale;
+            for (size_t i = 0; i < count; ++i)
+                y[i] += float(q[i]) * scale;
+        }
+    });
+
+    return true;
+}
+
+} // namespace wm
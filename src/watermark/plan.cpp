@@ -0,0 +1,80 @@
+#include "wm/watermark/plan.h"
+
+#include "wm/watermark/block_permutation.h"
+#include "wm/watermark/pn.h"
+
+namespace wm {
+
+bool build_plan(
+    Plan& plan,
+    uint32_t width,
+    uint32_t height,
+    uint32_t payload_len,
+    uint64_t key,
+    const Scheme& scheme,
+    bool tables
+) {
+    BlockLayout layout;
+    if (!make_block_layout(width, height, payload_len, layout))
+        return false;
+
+    const bool feistel = scheme.permutation == PermutationScheme::Feistel;
+    if (!tables && !feistel)
+        return false;
+
+    plan.width = width;
+    plan.height = height;
+    plan.payload_len = payload_len;
+    plan.key = key;
+    plan.scheme = scheme;
+    plan.layout = layout;
+
+    const uint32_t total = layout.total_blocks;
+
+    if (feistel)
+        make_feistel_permutation(key, total, plan.feistel);
+
+    plan.block_of_slot.clear();
+    plan.bit_of_block.clear();
+    plan.pn_signs.clear();
+
+    if (!tables)
+        return true;
+
+    // -------------------------
+    // Key permutation and its inverse as bit assignments
+    // -------------------------
+    plan.block_of_slot.resize(total);
+    if (feistel) {
+        for (uint32_t s = 0; s < total; ++s)
+            plan.block_of_slot[s] = feistel_permute(plan.feistel, s);
+    } else {
+        generate_block_permutation(key, plan.block_of_slot.data(), total);
+    }
+
+    plan.bit_of_block.assign(total, NO_BIT);
+    for (uint32_t s = 0; s < layout.used_slots; ++s)
+        plan.bit_of_block[plan.block_of_slot[s]] = s / layout.blocks_per_bit;
+
+    // -------------------------
+    // PN signs
+    // -------------------------
+    plan.pn_signs.assign(total, 0);
+
+    // Hashes are vectorized across consecutive blocks; unused blocks are
+    // cleared afterwards
+    if (scheme.pn == PnScheme::Packed)
+        pn_masks_v2(key, plan.bit_of_block.data(), 0, total,
+                    plan.pn_signs.data());
+    else
+        pn_masks(key, plan.bit_of_block.data(), 0, total,
+                 plan.pn_signs.data());
+
+    for (uint32_t p = 0; p < total; ++p)
+        if (plan.bit_of_block[p] == NO_BIT)
+            plan.pn_signs[p] = 0;
+
+    return true;
+}
+
+} // namespace wm
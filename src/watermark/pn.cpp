@@ -1,5 +1,15 @@
 #include "wm/watermark/pn.h"
 
+#include "wm/transform/dct_mask.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define WM_PN_X86 1
+#include <immintrin.h>
+#else
+#define WM_PN_X86 0
+#endif
+
 namespace wm {
 
 // SplitMix64
@@ -10,15 +20,19 @@ static inline uint64_t splitmix64(uint64_t& x) {
     return z ^ (z >> 31);
 }
 
+static constexpr uint64_t PN_BIT_MUL    = 0x100000001b3ULL;
+static constexpr uint64_t PN_BLOCK_MUL  = 0xC6A4A7935BD1E995ULL;
+static constexpr uint64_t PN_CHIP_MUL   = 0x9E3779B97F4A7C15ULL;
+
 int8_t pn_chip(uint64_t key,
                uint32_t bit_index,
                uint32_t block_index,
                uint32_t chip_index)
 {
     uint64_t seed = key;
-    seed ^= uint64_t(bit_index)  * 0x100000001b3ULL;
-    seed ^= uint64_t(block_index) * 0xC6A4A7935BD1E995ULL;
-    seed ^= uint64_t(chip_index) * 0x9E3779B97F4A7C15ULL;
+    seed ^= uint64_t(bit_index)  * PN_BIT_MUL;
+    seed ^= uint64_t(block_index) * PN_BLOCK_MUL;
+    seed ^= uint64_t(chip_index) * PN_CHIP_MUL;
 
     uint64_t x = seed;
     uint64_t r = splitmix64(x);
@@ -26,5 +40,211 @@ int8_t pn_chip(uint64_t key,
     return (r & 1ULL) ? +1 : -1;
 }
 
+uint8_t pn_mask(uint64_t key,
+                uint32_t bit_index,
+                uint32_t block_index)
+{
+    uint8_t mask = 0;
+    for (uint32_t i = 0; i < DCT_MASK_SIZE; ++i)
+        if (pn_chip(key, bit_index, block_index, i) > 0)
+            mask |= uint8_t(1u << i);
+    return mask;
+}
+
+// --------------------------------
+// v2
+// --------------------------------
+static constexpr uint64_t PN_V2_TAG     = 0xD1B54A32D192ED03ULL;
+static constexpr uint8_t  PN_CHIP_BITS  = (1u << DCT_MASK_SIZE) - 1u;
+
+uint8_t pn_mask_v2(uint64_t key,
+                   uint32_t bit_index,
+                   uint32_t block_index)
+{
+    uint64_t x = key ^ PN_V2_TAG;
+    x ^= uint64_t(bit_index)   * PN_BIT_MUL;
+    x ^= uint64_t(block_index) * PN_BLOCK_MUL;
+
+    return uint8_t(splitmix64(x) & PN_CHIP_BITS);
+}
+
+static void pn_masks_v2_scalar(uint64_t key,
+                               const uint32_t* bit_index,
+                               uint32_t first_block,
+                               uint32_t count,
+                               uint8_t* out)
+{
+    for (uint32_t i = 0; i < count; ++i)
+        out[i] = pn_mask_v2(key, bit_index[i], first_block + i);
+}
+
+static void pn_masks_scalar(uint64_t key,
+                            const uint32_t* bit_index,
+                            uint32_t first_block,
+                            uint32_t count,
+                            uint8_t* out)
+{
+    for (uint32_t i = 0; i < count; ++i)
+        out[i] = pn_mask(key, bit_index[i], first_block + i);
+}
+
+#if WM_PN_X86
+
+// 64-bit lane multiply from 32×32→64 partial products (AVX2 has no
+// native 64-bit mullo)
+__attribute__((target("avx2")))
+static inline __m256i mullo64_avx2(__m256i a, __m256i b) {
+    __m256i lo    = _mm256_mul_epu32(a, b);
+    __m256i a_hi  = _mm256_srli_epi64(a, 32);
+    __m256i b_hi  = _mm256_srli_epi64(b, 32);
+    __m256i cross = _mm256_add_epi64(_mm256_mul_epu32(a_hi, b),
+                                     _mm256_mul_epu32(a, b_hi));
+    return _mm256_add_epi64(lo, _mm256_slli_epi64(cross, 32));
+}
+
+__attribute__((target("avx2")))
+static void pn_masks_v2_avx2(uint64_t key,
+                             const uint32_t* bit_index,
+                             uint32_t first_block,
+                             uint32_t count,
+                             uint8_t* out)
+{
+    const __m256i base    = _mm256_set1_epi64x(int64_t(key ^ PN_V2_TAG));
+    const __m256i bit_mul = _mm256_set1_epi64x(int64_t(PN_BIT_MUL));
+    const __m256i blk_mul = _mm256_set1_epi64x(int64_t(PN_BLOCK_MUL));
+    const __m256i golden  = _mm256_set1_epi64x(int64_t(0x9e3779b97f4a7c15ULL));
+    const __m256i m1      = _mm256_set1_epi64x(int64_t(0xbf58476d1ce4e5b9ULL));
+    const __m256i m2      = _mm256_set1_epi64x(int64_t(0x94d049bb133111ebULL));
+    const __m256i step    = _mm256_set1_epi64x(4);
+
+    __m256i block = _mm256_setr_epi64x(first_block, int64_t(first_block) + 1,
+                                       int64_t(first_block) + 2,
+                                       int64_t(first_block) + 3);
+
+    uint32_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256i bits = _mm256_cvtepu32_epi64(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(bit_index + i)));
+
+        __m256i z = _mm256_xor_si256(base, mullo64_avx2(bits, bit_mul));
+        z = _mm256_xor_si256(z, mullo64_avx2(block, blk_mul));
+
+        // SplitMix64 finalizer
+        z = _mm256_add_epi64(z, golden);
+        z = mullo64_avx2(_mm256_xor_si256(z, _mm256_srli_epi64(z, 30)), m1);
+        z = mullo64_avx2(_mm256_xor_si256(z, _mm256_srli_epi64(z, 27)), m2);
+        z = _mm256_xor_si256(z, _mm256_srli_epi64(z, 31));
+
+        alignas(32) uint64_t lanes[4];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), z);
+        for (int l = 0; l < 4; ++l)
+            out[i + l] = uint8_t(lanes[l] & PN_CHIP_BITS);
+
+        block = _mm256_add_epi64(block, step);
+    }
+
+    pn_masks_v2_scalar(key, bit_index + i, first_block + i, count - i,
+                       out + i);
+}
+
+// SplitMix64 of `seed` in each lane (one step from the seed, as pn_chip)
+__attribute__((target("avx2")))
+static inline __m256i splitmix64_avx2(__m256i z) {
+    const __m256i golden = _mm256_set1_epi64x(int64_t(0x9e3779b97f4a7c15ULL));
+    const __m256i m1     = _mm256_set1_epi64x(int64_t(0xbf58476d1ce4e5b9ULL));
+    const __m256i m2     = _mm256_set1_epi64x(int64_t(0x94d049bb133111ebULL));
+
+    z = _mm256_add_epi64(z, golden);
+    z = mullo64_avx2(_mm256_xor_si256(z, _mm256_srli_epi64(z, 30)), m1);
+    z = mullo64_avx2(_mm256_xor_si256(z, _mm256_srli_epi64(z, 27)), m2);
+    return _mm256_xor_si256(z, _mm256_srli_epi64(z, 31));
+}
+
+// v1: the (key, bit, block) part of the seed is shared by a block's
+// chips; each chip XORs in its own constant and gets its own SplitMix
+__attribute__((target("avx2")))
+static void pn_masks_avx2(uint64_t key,
+                          const uint32_t* bit_index,
+                          uint32_t first_block,
+                          uint32_t count,
+                          uint8_t* out)
+{
+    const __m256i base    = _mm256_set1_epi64x(int64_t(key));
+    const __m256i bit_mul = _mm256_set1_epi64x(int64_t(PN_BIT_MUL));
+    const __m256i blk_mul = _mm256_set1_epi64x(int64_t(PN_BLOCK_MUL));
+    const __m256i one     = _mm256_set1_epi64x(1);
+    const __m256i step    = _mm256_set1_epi64x(4);
+
+    __m256i block = _mm256_setr_epi64x(first_block, int64_t(first_block) + 1,
+                                       int64_t(first_block) + 2,
+                                       int64_t(first_block) + 3);
+
+    uint32_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256i bits = _mm256_cvtepu32_epi64(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(bit_index + i)));
+
+        __m256i seed = _mm256_xor_si256(base, mullo64_avx2(bits, bit_mul));
+        seed = _mm256_xor_si256(seed, mullo64_avx2(block, blk_mul));
+
+        __m256i mask = _mm256_setzero_si256();
+        for (uint32_t c = 0; c < DCT_MASK_SIZE; ++c) {
+            __m256i chip = _mm256_set1_epi64x(int64_t(c * PN_CHIP_MUL));
+            __m256i r = splitmix64_avx2(_mm256_xor_si256(seed, chip));
+            mask = _mm256_or_si256(
+                mask, _mm256_slli_epi64(_mm256_and_si256(r, one), c));
+        }
+
+        alignas(32) uint64_t lanes[4];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), mask);
+        for (int l = 0; l < 4; ++l)
+            out[i + l] = uint8_t(lanes[l]);
+
+        block = _mm256_add_epi64(block, step);
+    }
+
+    pn_masks_scalar(key, bit_index + i, first_block + i, count - i,
+                    out + i);
+}
+
+static bool pn_has_avx2() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+
+static const bool g_pn_avx2 = pn_has_avx2();
+
+#endif
+
+void pn_masks(uint64_t key,
+              const uint32_t* bit_index,
+              uint32_t first_block,
+              uint32_t count,
+              uint8_t* masks_out)
+{
+#if WM_PN_X86
+    if (g_pn_avx2) {
+        pn_masks_avx2(key, bit_index, first_block, count, masks_out);
+        return;
+    }
+#endif
+    pn_masks_scalar(key, bit_index, first_block, count, masks_out);
+}
+
+void pn_masks_v2(uint64_t key,
+                 const uint32_t* bit_index,
+                 uint32_t first_block,
+                 uint32_t count,
+                 uint8_t* masks_out)
+{
+#if WM_PN_X86
+    if (g_pn_avx2) {
+        pn_masks_v2_avx2(key, bit_index, first_block, count, masks_out);
+        return;
+    }
+#endif
+    pn_masks_v2_scalar(key, bit_index, first_block, count, masks_out);
+}
+
 } // namespace wm
 #include <vector>
\ No newline at end of file
@@ -0,0 +1,62 @@
+#include "wm/watermark/presence.h"
+
+#include "wm/watermark/sequential.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace wm {
+
+double chi2_tail_bound(double t, uint32_t n) {
+    if (n == 0 || t <= n)
+        return 1.0;
+
+    const double r = t / n;
+    return std::exp(0.5 * n * (std::log(r) + 1.0 - r));
+}
+
+bool detect_presence(
+    const Plan& plan,
+    const Image& img,
+    const PresenceParams& params,
+    PresenceOutcome& outcome
+) {
+    if (img.width != plan.width || img.height != plan.height)
+        return false;
+
+    const BlockLayout& L = plan.layout;
+    const uint32_t n = plan.payload_len;
+    const uint32_t m = std::min(params.blocks_per_bit, L.blocks_per_bit);
+
+    outcome = PresenceOutcome{};
+    if (n == 0 || m == 0)
+        return false;
+
+    double T = 0.0;
+
+    for (uint32_t bit = 0; bit < n; ++bit) {
+        double sum = 0.0;
+        double energy = 0.0;
+
+        for (uint32_t k = 0; k < m; ++k) {
+            uint32_t block =
+                plan_block_of_slot(plan, bit * L.blocks_per_bit + k);
+            double c = block_correlation(plan, img, block);
+            sum += c;
+            energy += c * c;
+        }
+
+        // A flat sample carries no evidence either way: z_b = 0
+        if (energy > 0.0)
+            T += sum * sum / energy;
+    }
+
+    outcome.score = static_cast<float>((T - n) / std::sqrt(2.0 * n));
+    outcome.false_positive_bound =
+        static_cast<float>(chi2_tail_bound(T, n));
+    outcome.blocks_read = n * m;
+
+    return true;
+}
+
+} // namespace wm
@@ -0,0 +1,128 @@
+#include "wm/watermark/sequential.h"
+
+#include "wm/transform/dct_basis.h"
+#include "wm/transform/dwt.h"
+#include "wm/watermark/extract_block.h"
+
+#include <cmath>
+#include <vector>
+
+namespace wm {
+
+float block_correlation(const Plan& plan, const Image& img, uint32_t block) {
+    constexpr uint32_t N = DWT_TILE;
+
+    const BlockLayout& L = plan.layout;
+    const uint32_t b = block / L.blocks_per_band;
+    const uint32_t q = block % L.blocks_per_band;
+    const uint32_t bx = q % L.blocks_x;
+    const uint32_t by = q / L.blocks_x;
+
+    const uint32_t bit = plan_bit_of_block(plan, block);
+    if (bit == NO_BIT)
+        return 0.0f;
+
+    alignas(64) float tile[N * N];
+    dwt2_haar_tile(img.Y + size_t(by) * N * img.width + bx * N,
+                   img.width, tile);
+
+    // HL2 sits right of LL2, LH2 below it (see embed_tile)
+    const float* detail = b ? tile + (N / 4) * N : tile + N / 4;
+
+    float coeff[DCT_MASK_SIZE];
+    analyze_masked(detail, N, mid_freq_basis(), coeff);
+
+    return correlate_mask_coeffs(coeff, plan_pn_signs(plan, block, bit));
+}
+
+// log(½·e^u + ½·e^v) without overflow
+static double log_mean_exp(double u, double v) {
+    double hi = u > v ? u : v;
+    return hi + std::log1p(std::exp(-std::fabs(u - v))) - std::log(2.0);
+}
+
+bool extract_sequential(
+    const Plan& plan,
+    const Image& img,
+    const SequentialParams& params,
+    int8_t* bits_out,
+    float* confidence_out,
+    SequentialOutcome& outcome
+) {
+    if (img.width != plan.width || img.height != plan.height)
+        return false;
+
+    const BlockLayout& L = plan.layout;
+    const uint32_t n = plan.payload_len;
+
+    const double p = params.block_accuracy;
+    const double alpha = params.false_accept;
+    const double beta = params.false_reject;
+
+    const double log_2p = std::log(2.0 * p);
+    const double log_2q = std::log(2.0 * (1.0 - p));
+    const double upper = std::log((1.0 - beta) / alpha);
+    const double lower = std::log(beta / (1.0 - alpha));
+    const double bit_margin =
+        std::log((1.0 - beta) / beta) / std::log(p / (1.0 - p));
+
+    std::vector<int32_t> plus(n, 0);
+    std::vector<int32_t> minus(n, 0);
+    std::vector<double> llr(n, 0.0);
+    double total = 0.0;
+
+    outcome = SequentialOutcome{};
+
+    for (uint32_t k = 0; k < L.blocks_per_bit; ++k) {
+        for (uint32_t bit = 0; bit < n; ++bit) {
+            uint32_t block =
+                plan_block_of_slot(plan, bit * L.blocks_per_bit + k);
+            float corr = block_correlation(plan, img, block);
+
+            if (corr >= 0.0f)
+                ++plus[bit];
+            else
+                ++minus[bit];
+
+            const double a = plus[bit];
+            const double d = minus[bit];
+            double updated = log_mean_exp(a * log_2p + d * log_2q,
+                                          a * log_2q + d * log_2p);
+
+            total += updated - llr[bit];
+            llr[bit] = updated;
+        }
+
+        outcome.blocks_read += n;
+        outcome.rounds = k + 1;
+
+        if (total <= lower) {
+            outcome.verdict = SequentialVerdict::Tampered;
+            break;
+        }
+
+        if (total >= upper) {
+            bool decided = true;
+            for (uint32_t bit = 0; bit < n && decided; ++bit)
+                decided = std::abs(plus[bit] - minus[bit]) >= bit_margin;
+
+            if (decided) {
+                outcome.verdict = SequentialVerdict::Verified;
+                break;
+            }
+        }
+    }
+
+    const float votes = static_cast<float>(outcome.rounds);
+
+    for (uint32_t bit = 0; bit < n; ++bit) {
+        int32_t sum = plus[bit] - minus[bit];
+
+        bits_out[bit] = (sum >= 0) ? +1 : -1;
+        confidence_out[bit] = std::fabs(static_cast<float>(sum)) / votes;
+    }
+
+    return true;
+}
+
+} // namespace wm
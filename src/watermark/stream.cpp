@@ -0,0 +1,168 @@
+#include "wm/watermark/stream.h"
+
+#include "wm/transform/dct_basis.h"
+#include "wm/transform/dwt.h"
+#include "wm/watermark/embed_tile.h"
+#include "wm/watermark/extract_block.h"
+
+#include <cmath>
+
+namespace wm {
+
+// Streams only look up which bit a block carries and its PN signs. The
+// Feistel permutation answers both per block, so no tables are built. The
+// v1 shuffle cannot be inverted without its table, so bit_of_block is
+// kept (4 bytes per block); the permutation is dropped and PN signs are
+// recomputed per block instead of stored.
+static bool build_stream_plan(
+    Plan& plan,
+    uint32_t width,
+    uint32_t height,
+    uint32_t payload_len,
+    uint64_t key,
+    const Scheme& scheme
+) {
+    const bool tables = scheme.permutation != PermutationScheme::Feistel;
+
+    if (!build_plan(plan, width, height, payload_len, key, scheme, tables))
+        return false;
+
+    std::vector<uint32_t>().swap(plan.block_of_slot);
+    std::vector<uint8_t>().swap(plan.pn_signs);
+    return true;
+}
+
+// --------------------------------
+// Streaming embed
+// --------------------------------
+bool embed_stream_begin(
+    EmbedStream& s,
+    uint32_t width,
+    uint32_t height,
+    const int8_t* payload_bits,
+    uint32_t payload_len,
+    uint64_t key,
+    float alpha,
+    const Scheme& scheme
+) {
+    if (!build_stream_plan(s.plan, width, height, payload_len, key, scheme))
+        return false;
+
+    s.next_band = 0;
+    s.alpha = alpha;
+    s.payload.assign(payload_bits, payload_bits + payload_len);
+
+    return true;
+}
+
+bool embed_stream_push(EmbedStream& s, float* band) {
+    if (embed_stream_complete(s))
+        return false;
+
+    embed_tile_row(
+        band,
+        s.plan.width,
+        s.next_band,
+        s.plan,
+        s.payload.data(),
+        s.alpha
+    );
+
+    ++s.next_band;
+    return true;
+}
+
+bool embed_stream_complete(const EmbedStream& s) {
+    return s.next_band >= s.plan.layout.blocks_y;
+}
+
+// --------------------------------
+// Streaming extraction
+// --------------------------------
+bool extract_stream_begin(
+    ExtractStream& s,
+    uint32_t width,
+    uint32_t height,
+    uint32_t payload_len,
+    uint64_t key,
+    const Scheme& scheme
+) {
+    if (!build_stream_plan(s.plan, width, height, payload_len, key, scheme))
+        return false;
+
+    s.next_band = 0;
+    s.votes.assign(payload_len, 0);
+    s.detail.resize(size_t(width / 4) * (STREAM_BAND_ROWS / 4) * 2);
+
+    return true;
+}
+
+bool extract_stream_push(ExtractStream& s, const float* band) {
+    const Plan& plan = s.plan;
+    const BlockLayout& L = plan.layout;
+
+    if (s.next_band >= L.blocks_y)
+        return false;
+
+    // -------------------------
+    // Detail subbands of this band: one 8-row strip of HL2 and LH2
+    // -------------------------
+    const uint32_t qw = plan.width / 4;
+    float* hl = s.detail.data();
+    float* lh = hl + size_t(qw) * (STREAM_BAND_ROWS / 4);
+
+    haar_detail2(band, plan.width, STREAM_BAND_ROWS, hl, lh);
+
+    // -------------------------
+    // Votes
+    // -------------------------
+    const MaskBasis& basis = mid_freq_basis();
+    const uint32_t by = s.next_band;
+
+    for (uint32_t b = 0; b < 2; ++b) {
+        const float* strip = b ? lh : hl;
+
+        for (uint32_t bx = 0; bx < L.blocks_x; ++bx) {
+            uint32_t p = b * L.blocks_per_band + by * L.blocks_x + bx;
+            uint32_t bit = plan_bit_of_block(plan, p);
+
+            if (bit == NO_BIT)
+                continue;
+
+            float coeff[DCT_MASK_SIZE];
+            analyze_masked(strip + bx * 8, qw, basis, coeff);
+
+            float corr =
+                correlate_mask_coeffs(coeff, plan_pn_signs(plan, p, bit));
+
+            s.votes[bit] += (corr >= 0.0f) ? +1 : -1;
+        }
+    }
+
+    ++s.next_band;
+    return true;
+}
+
+bool extract_stream_finish(
+    const ExtractStream& s,
+    int8_t* bits_out,
+    float* confidence_out
+) {
+    const BlockLayout& L = s.plan.layout;
+
+    if (s.next_band < L.blocks_y)
+        return false;
+
+    for (uint32_t bit = 0; bit < s.plan.payload_len; ++bit) {
+        int32_t sum = s.votes[bit];
+
+        bits_out[bit] = (sum >= 0) ? +1 : -1;
+        confidence_out[bit] =
+            std::fabs(static_cast<float>(sum)) /
+            static_cast<float>(L.blocks_per_bit);
+    }
+
+    return true;
+}
+
+} // namespace wm
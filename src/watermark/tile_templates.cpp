@@ -0,0 +1,75 @@
+#include "wm/watermark/tile_templates.h"
+
+#include "wm/transform/dct_mask.h"
+#include "wm/watermark/embed_block.h"
+
+namespace wm {
+
+// --------------------------------
+// Templates
+// --------------------------------
+// Each template is the tile synthesis of a unit-weight pattern placed in
+// the same spot embed_tile uses: HL2 right of LL2, LH2 below it.
+static TileTemplates make_mid_freq_tile_templates() {
+    constexpr uint32_t N = DWT_TILE;
+
+    TileTemplates t;
+    t.mask_count = 1u << DCT_MASK_SIZE;
+    t.data.resize(size_t(2) * t.mask_count * N * N);
+
+    for (uint32_t b = 0; b < 2; ++b) {
+        for (uint32_t m = 0; m < t.mask_count; ++m) {
+            alignas(64) float tile[N * N] = {};
+
+            float* block = b ? tile + (N / 4) * N : tile + N / 4;
+            embed_mask_block(block, N, 1.0f, uint8_t(m));
+
+            float* out = t.data.data() + (size_t(b) * t.mask_count + m) * N * N;
+            idwt2_haar_tile(tile, out, N);
+        }
+    }
+
+    return t;
+}
+
+const TileTemplates& mid_freq_tile_templates() {
+    static const TileTemplates templates = make_mid_freq_tile_templates();
+    return templates;
+}
+
+// --------------------------------
+// Matched filter
+// --------------------------------
+void correlate_tile(
+    const float* pixels,
+    uint32_t stride,
+    const float* tmpl0,
+    const float* tmpl1,
+    float* corr0,
+    float* corr1
+) {
+    constexpr uint32_t N = DWT_TILE;
+    constexpr uint32_t K = 8;
+
+    float a0[K] = {};
+    float a1[K] = {};
+
+    for (uint32_t y = 0; y < N; ++y) {
+        const float* s = pixels + size_t(y) * stride;
+        const float* q0 = tmpl0 + y * N;
+        const float* q1 = tmpl1 + y * N;
+
+        for (uint32_t x = 0; x < N; x += K)
+            for (uint32_t k = 0; k < K; ++k) {
+                a0[k] += s[x + k] * q0[x + k];
+                a1[k] += s[x + k] * q1[x + k];
+            }
+    }
+
+    *corr0 = ((a0[0] + a0[4]) + (a0[2] + a0[6])) +
+             ((a0[1] + a0[5]) + (a0[3] + a0[7]));
+    *corr1 = ((a1[0] + a1[4]) + (a1[2] + a1[6])) +
+             ((a1[1] + a1[5]) + (a1[3] + a1[7]));
+}
+
+} // namespace wm
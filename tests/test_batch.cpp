@@ -0,0 +1,141 @@
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "wm/api.h"
+#include "wm/thread_pool.h"
+
+using namespace wm;
+
+static std::vector<float> smooth(uint32_t W, uint32_t H, float phase) {
+    std::vector<float> Y(W * H);
+    for (uint32_t y = 0; y < H; ++y)
+        for (uint32_t x = 0; x < W; ++x)
+            Y[y * W + x] =
+                110.0f +
+                30.0f * std::sin(0.04f * x + phase) +
+                20.0f * std::cos(0.03f * y);
+    return Y;
+}
+
+// ----------------------------
+// Work stealing runs every item once
+// ----------------------------
+void test_stealing_covers_items() {
+    ThreadPool pool(3);
+
+    const uint32_t N = 257;
+    std::vector<uint32_t> order(N);
+    for (uint32_t i = 0; i < N; ++i)
+        order[i] = N - 1 - i;
+
+    std::vector<std::atomic<uint32_t>> hits(N);
+    for (auto& h : hits)
+        h = 0;
+
+    for (uint32_t threads : { 1u, 3u, 0u })
+        pool.parallel_for_stealing(order.data(), N, threads,
+                                   [&](uint32_t i) { hits[i]++; });
+
+    for (uint32_t i = 0; i < N; ++i)
+        assert(hits[i] == 3);
+
+    printf("[PASS] Work stealing covers every item once\n");
+}
+
+// ----------------------------
+// Batch == per-image calls, with per-image status
+// ----------------------------
+void test_batch_matches_single() {
+    struct Size {
+        uint32_t w;
+        uint32_t h;
+    };
+
+    // Mixed sizes, one with invalid dimensions
+    const Size sizes[] = {
+        { 256, 256 }, { 64, 64 }, { 512, 320 }, { 100, 64 }, { 128, 96 },
+    };
+    const uint32_t N = sizeof(sizes) / sizeof(sizes[0]);
+    const uint32_t PAYLOAD_LEN = 8;
+    const uint64_t KEY = 0xBA7C4ULL;
+
+    std::vector<std::vector<int8_t>> bits(N);
+    std::vector<std::vector<float>> batch_y(N);
+    std::vector<std::vector<float>> single_y(N);
+    std::vector<WM_Image> images(N);
+    std::vector<WM_Payload> payloads(N);
+
+    for (uint32_t i = 0; i < N; ++i) {
+        bits[i].resize(PAYLOAD_LEN);
+        for (uint32_t b = 0; b < PAYLOAD_LEN; ++b)
+            bits[i][b] = ((b + i) % 3) ? +1 : -1;
+
+        batch_y[i] = smooth(sizes[i].w, sizes[i].h, float(i));
+        single_y[i] = batch_y[i];
+
+        images[i] = { sizes[i].w, sizes[i].h, batch_y[i].data() };
+        payloads[i] = { bits[i].data(), PAYLOAD_LEN };
+    }
+
+    std::vector<WM_Status> statuses(N, WM_ERR_INTERNAL);
+    assert(wm_embed_batch(images.data(), payloads.data(), N, KEY, 2.0f,
+                          nullptr, statuses.data()) == WM_OK);
+
+    for (uint32_t i = 0; i < N; ++i) {
+        WM_Image single{ sizes[i].w, sizes[i].h, single_y[i].data() };
+        WM_Status st = wm_embed(&single, &payloads[i], KEY, 2.0f);
+
+        assert(statuses[i] == st);
+        assert(std::memcmp(batch_y[i].data(), single_y[i].data(),
+                           batch_y[i].size() * sizeof(float)) == 0);
+    }
+    assert(statuses[3] == WM_ERR_INVALID_DIMENSIONS);
+
+    // ----------------------------
+    // Extract the batch back
+    // ----------------------------
+    std::vector<std::vector<int8_t>> out_bits(N);
+    std::vector<std::vector<float>> conf(N);
+    std::vector<WM_ExtractResult> results(N);
+
+    for (uint32_t i = 0; i < N; ++i) {
+        out_bits[i].resize(PAYLOAD_LEN);
+        conf[i].resize(PAYLOAD_LEN);
+        results[i] = {};
+        results[i].bits = out_bits[i].data();
+        results[i].confidence = conf[i].data();
+        results[i].length = PAYLOAD_LEN;
+    }
+
+    WM_ExtractOptions opt{};
+    opt.threads = 2;
+    assert(wm_extract_batch(images.data(), N, KEY, results.data(), &opt,
+                            statuses.data()) == WM_OK);
+
+    for (uint32_t i = 0; i < N; ++i) {
+        if (i == 3) {
+            assert(statuses[i] == WM_ERR_UNVERIFIABLE);
+            continue;
+        }
+
+        assert(statuses[i] == WM_OK);
+        assert(out_bits[i] == bits[i]);
+    }
+
+    printf("[PASS] Batch calls match per-image calls\n");
+}
+
+// ----------------------------
+// Main
+// ----------------------------
+int main() {
+    test_stealing_covers_items();
+    test_batch_matches_single();
+
+    printf("All batch tests passed.\n");
+    return 0;
+}
@@ -0,0 +1,164 @@
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "wm/api.h"
+#include "wm/watermark/block_permutation.h"
+#include "wm/watermark/plan.h"
+#include "wm/watermark/pn.h"
+
+#include "test_fixtures.h"
+
+using namespace wm;
+using namespace wm_test;
+
+// ----------------------------
+// Plan tables agree with the primitives
+// ----------------------------
+void test_plan_tables() {
+    Plan plan;
+    assert(build_plan(plan, W, H, PAYLOAD_LEN, KEY));
+
+    const BlockLayout& L = plan.layout;
+    std::vector<uint32_t> perm(L.total_blocks);
+    generate_block_permutation(KEY, perm.data(), L.total_blocks);
+
+    assert(plan.block_of_slot == perm);
+
+    for (uint32_t s = 0; s < L.total_blocks; ++s) {
+        uint32_t p = perm[s];
+
+        if (s >= L.used_slots) {
+            assert(plan.bit_of_block[p] == NO_BIT);
+            continue;
+        }
+
+        uint32_t bit = s / L.blocks_per_bit;
+        assert(plan.bit_of_block[p] == bit);
+        assert(plan.pn_signs[p] == pn_mask(KEY, bit, p));
+    }
+
+    printf("[PASS] Plan tables\n");
+}
+
+// ----------------------------
+// Context calls == plain calls
+// ----------------------------
+void test_context_matches_plain() {
+    int8_t bits[PAYLOAD_LEN];
+    make_bits(bits);
+    WM_Payload payload{ bits, PAYLOAD_LEN };
+
+    WM_Context* ctx = nullptr;
+    assert(wm_context_create(W, H, PAYLOAD_LEN, KEY, nullptr, &ctx) ==
+           WM_OK);
+
+    std::vector<float> a = smooth();
+    std::vector<float> b = a;
+    WM_Image ia{ W, H, a.data() };
+    WM_Image ib{ W, H, b.data() };
+
+    assert(wm_embed_ctx(ctx, &ia, &payload, 2.0f, nullptr) == WM_OK);
+    assert(wm_embed(&ib, &payload, KEY, 2.0f) == WM_OK);
+    assert(std::memcmp(a.data(), b.data(), a.size() * sizeof(float)) == 0);
+
+    int8_t out_ctx[PAYLOAD_LEN], out_plain[PAYLOAD_LEN];
+    float conf_ctx[PAYLOAD_LEN], conf_plain[PAYLOAD_LEN];
+
+    WM_ExtractResult rc{};
+    rc.bits = out_ctx;
+    rc.confidence = conf_ctx;
+    rc.length = PAYLOAD_LEN;
+
+    WM_ExtractResult rp = rc;
+    rp.bits = out_plain;
+    rp.confidence = conf_plain;
+
+    assert(wm_extract_ctx(ctx, &ia, &rc, nullptr) == WM_OK);
+    assert(wm_extract(&ia, KEY, &rp) == WM_OK);
+
+    for (uint32_t i = 0; i < PAYLOAD_LEN; ++i) {
+        assert(out_ctx[i] == bits[i]);
+        assert(out_ctx[i] == out_plain[i]);
+        assert(conf_ctx[i] == conf_plain[i]);
+    }
+    assert(rc.verdict == rp.verdict);
+
+    // ----------------------------
+    // Mismatched inputs are rejected
+    // ----------------------------
+    WM_Image wrong{ W - 32, H, a.data() };
+    assert(wm_extract_ctx(ctx, &wrong, &rc, nullptr) ==
+           WM_ERR_INVALID_DIMENSIONS);
+
+    WM_Payload short_payload{ bits, PAYLOAD_LEN - 1 };
+    assert(wm_embed_ctx(ctx, &ia, &short_payload, 2.0f, nullptr) ==
+           WM_ERR_INVALID_ARGUMENT);
+
+    wm_context_destroy(ctx);
+
+    WM_Context* bad = nullptr;
+    assert(wm_context_create(W + 1, H, PAYLOAD_LEN, KEY, nullptr, &bad) ==
+           WM_ERR_INVALID_DIMENSIONS);
+    assert(wm_context_create(32, 32, 3, KEY, nullptr, &bad) ==
+           WM_ERR_INSUFFICIENT_CAPACITY);
+    assert(bad == nullptr);
+
+    printf("[PASS] Context calls match plain calls\n");
+}
+
+// ----------------------------
+// v2 scheme through a context
+// ----------------------------
+void test_context_v2_scheme() {
+    int8_t bits[PAYLOAD_LEN];
+    make_bits(bits, PAYLOAD_LEN, 1);
+    WM_Payload payload{ bits, PAYLOAD_LEN };
+
+    WM_Scheme scheme{};
+    scheme.permutation = WM_PERMUTATION_V2_FEISTEL;
+    scheme.pn = WM_PN_V2_PACKED;
+
+    WM_Context* ctx = nullptr;
+    assert(wm_context_create(W, H, PAYLOAD_LEN, KEY, &scheme, &ctx) ==
+           WM_OK);
+
+    std::vector<float> Y = smooth();
+    WM_Image img{ W, H, Y.data() };
+    assert(wm_embed_ctx(ctx, &img, &payload, 2.0f, nullptr) == WM_OK);
+
+    int8_t out[PAYLOAD_LEN];
+    float conf[PAYLOAD_LEN];
+    WM_ExtractResult result{};
+    result.bits = out;
+    result.confidence = conf;
+    result.length = PAYLOAD_LEN;
+
+    assert(wm_extract_ctx(ctx, &img, &result, nullptr) == WM_OK);
+    for (uint32_t i = 0; i < PAYLOAD_LEN; ++i)
+        assert(out[i] == bits[i]);
+    assert(result.verdict == WM_VERDICT_VERIFIED);
+
+    // Same content read with v1 PN is not verified
+    WM_ExtractOptions v1_pn{};
+    v1_pn.scheme.permutation = WM_PERMUTATION_V2_FEISTEL;
+    assert(wm_extract_ex(&img, KEY, &result, &v1_pn) == WM_OK);
+    assert(result.verdict != WM_VERDICT_VERIFIED);
+
+    wm_context_destroy(ctx);
+
+    printf("[PASS] v2 scheme through a context\n");
+}
+
+// ----------------------------
+// Main
+// ----------------------------
+int main() {
+    test_plan_tables();
+    test_context_matches_plain();
+    test_context_v2_scheme();
+
+    printf("All context tests passed.\n");
+    return 0;
+}
@@ -55,12 +55,50 @@ void test_dc_only() {
     printf("[PASS] DCT DC-only\n");
 }
 
+// ----------------------------
+// Test 3: Fast kernels vs reference
+// ----------------------------
+void test_matches_reference() {
+    float input[64];
+    float ref[64], fast[64], sep[64];
+    float iref[64], ifast[64], isep[64];
+
+    uint32_t state = 12345u;
+    for (int trial = 0; trial < 256; ++trial) {
+        for (int i = 0; i < 64; ++i) {
+            state = state * 1664525u + 1013904223u;
+            input[i] = float(state >> 8) / float(1u << 24) * 510.0f - 255.0f;
+        }
+
+        dct8x8_reference(input, ref);
+        dct8x8(input, fast);
+        dct8x8_separable(input, sep);
+
+        for (int i = 0; i < 64; ++i) {
+            assert(nearly_equal(ref[i], fast[i], DCT_TOLERANCE));
+            assert(nearly_equal(ref[i], sep[i], DCT_TOLERANCE));
+        }
+
+        idct8x8_reference(ref, iref);
+        idct8x8(ref, ifast);
+        idct8x8_separable(ref, isep);
+
+        for (int i = 0; i < 64; ++i) {
+            assert(nearly_equal(iref[i], ifast[i], DCT_TOLERANCE));
+            assert(nearly_equal(iref[i], isep[i], DCT_TOLERANCE));
+        }
+    }
+
+    printf("[PASS] DCT fast/separable vs reference\n");
+}
+
 // ----------------------------
 // Main
 // ----------------------------
 int main() {
     test_round_trip();
     test_dc_only();
+    test_matches_reference();
 
     printf("All DCT tests passed.\n");
     return 0;
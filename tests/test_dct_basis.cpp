@@ -0,0 +1,88 @@
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+
+#include "wm/transform/dct.h"
+#include "wm/transform/dct_basis.h"
+
+using namespace wm;
+
+static bool nearly_equal(float a, float b, float eps = 1e-3f) {
+    return std::fabs(a - b) < eps;
+}
+
+static void fill_block(float* block, uint32_t stride, uint32_t seed) {
+    for (uint32_t y = 0; y < 8; ++y)
+        for (uint32_t x = 0; x < 8; ++x) {
+            seed = seed * 1664525u + 1013904223u;
+            block[y * stride + x] = float(seed >> 24) - 128.0f;
+        }
+}
+
+// ----------------------------
+// Test 1: Mid-frequency mask vs full DCT
+// ----------------------------
+void test_mid_freq_matches_dct() {
+    constexpr uint32_t STRIDE = 24;
+    float plane[8 * STRIDE];
+    float block[64];
+    float coeff[64];
+    float masked[DCT_MASK_SIZE];
+
+    const MaskBasis& basis = mid_freq_basis();
+    assert(basis.count == DCT_MASK_SIZE);
+
+    for (uint32_t trial = 0; trial < 64; ++trial) {
+        fill_block(plane, STRIDE, trial);
+
+        for (uint32_t y = 0; y < 8; ++y)
+            for (uint32_t x = 0; x < 8; ++x)
+                block[y * 8 + x] = plane[y * STRIDE + x];
+
+        dct8x8(block, coeff);
+        analyze_masked(plane, STRIDE, basis, masked);
+
+        for (uint32_t i = 0; i < DCT_MASK_SIZE; ++i) {
+            uint32_t idx = DCT_MID_FREQ_MASK[i].u * 8 + DCT_MID_FREQ_MASK[i].v;
+            assert(nearly_equal(masked[i], coeff[idx], DCT_TOLERANCE));
+        }
+    }
+
+    printf("[PASS] Masked analysis matches DCT (mid-frequency)\n");
+}
+
+// ----------------------------
+// Test 2: Arbitrary mask
+// ----------------------------
+void test_custom_mask() {
+    const DCTIndex mask[] = { {0, 0}, {7, 7}, {4, 5}, {0, 6} };
+    constexpr uint32_t N = sizeof(mask) / sizeof(mask[0]);
+
+    MaskBasis basis;
+    build_mask_basis(mask, N, basis);
+
+    float block[64];
+    float coeff[64];
+    float masked[N];
+
+    fill_block(block, 8, 99);
+    dct8x8(block, coeff);
+    analyze_masked(block, 8, basis, masked);
+
+    for (uint32_t i = 0; i < N; ++i)
+        assert(nearly_equal(masked[i], coeff[mask[i].u * 8 + mask[i].v],
+                            DCT_TOLERANCE));
+
+    printf("[PASS] Masked analysis matches DCT (custom mask)\n");
+}
+
+// ----------------------------
+// Main
+// ----------------------------
+int main() {
+    test_mid_freq_matches_dct();
+    test_custom_mask();
+
+    printf("All masked analysis tests passed.\n");
+    return 0;
+}
@@ -11,6 +11,89 @@ static bool nearly_equal(float a, float b, float eps = 1e-3f) {
     return std::fabs(a - b) < eps;
 }
 
+// ----------------------------
+// Reference: the original per-row / per-column implementation
+// ----------------------------
+static const float INV_SQRT2 = 0.7071067811865475f;
+
+static void reference_haar_1d(float* data, uint32_t n) {
+    std::vector<float> temp(n);
+
+    uint32_t half = n / 2;
+    for (uint32_t i = 0; i < half; ++i) {
+        float a = data[2 * i];
+        float b = data[2 * i + 1];
+        temp[i]        = (a + b) * INV_SQRT2;
+        temp[i + half] = (a - b) * INV_SQRT2;
+    }
+
+    for (uint32_t i = 0; i < n; ++i)
+        data[i] = temp[i];
+}
+
+static void reference_ihaar_1d(float* data, uint32_t n) {
+    std::vector<float> temp(n);
+
+    uint32_t half = n / 2;
+    for (uint32_t i = 0; i < half; ++i) {
+        float a = data[i];
+        float d = data[i + half];
+        temp[2 * i]     = (a + d) * INV_SQRT2;
+        temp[2 * i + 1] = (a - d) * INV_SQRT2;
+    }
+
+    for (uint32_t i = 0; i < n; ++i)
+        data[i] = temp[i];
+}
+
+static void reference_dwt2(float* data, uint32_t width, uint32_t height) {
+    uint32_t w = width;
+    uint32_t h = height;
+
+    for (int level = 0; level < 2; ++level) {
+        for (uint32_t y = 0; y < h; ++y)
+            reference_haar_1d(&data[y * width], w);
+
+        std::vector<float> col(h);
+        for (uint32_t x = 0; x < w; ++x) {
+            for (uint32_t y = 0; y < h; ++y)
+                col[y] = data[y * width + x];
+
+            reference_haar_1d(col.data(), h);
+
+            for (uint32_t y = 0; y < h; ++y)
+                data[y * width + x] = col[y];
+        }
+
+        w /= 2;
+        h /= 2;
+    }
+}
+
+static void reference_idwt2(float* data, uint32_t width, uint32_t height) {
+    uint32_t w = width / 4;
+    uint32_t h = height / 4;
+
+    for (int level = 0; level < 2; ++level) {
+        std::vector<float> col(h * 2);
+        for (uint32_t x = 0; x < w * 2; ++x) {
+            for (uint32_t y = 0; y < h * 2; ++y)
+                col[y] = data[y * width + x];
+
+            reference_ihaar_1d(col.data(), h * 2);
+
+            for (uint32_t y = 0; y < h * 2; ++y)
+                data[y * width + x] = col[y];
+        }
+
+        for (uint32_t y = 0; y < h * 2; ++y)
+            reference_ihaar_1d(&data[y * width], w * 2);
+
+        w *= 2;
+        h *= 2;
+    }
+}
+
 // ----------------------------
 // Test 1: Round-trip
 // ----------------------------
@@ -49,12 +132,57 @@ void test_constant_image() {
     printf("[PASS] DWT constant image\n");
 }
 
+// ----------------------------
+// Test 3: Bit-identical to the reference, caller scratch
+// ----------------------------
+void test_matches_reference() {
+    // 200 and 100 are not multiples of the 32-column strip; 96 is, but
+    // its level-2 width is not
+    const uint32_t sizes[][2] = { { 200, 12 }, { 96, 40 }, { 64, 64 } };
+
+    for (const auto& size : sizes) {
+        const uint32_t W = size[0], H = size[1];
+        std::vector<float> img(W * H);
+        std::vector<float> alloc(W * H);
+        std::vector<float> ref(W * H);
+
+        for (uint32_t i = 0; i < W * H; ++i)
+            img[i] = alloc[i] = ref[i] = static_cast<float>((i * 13) % 41) +
+                                         0.37f * static_cast<float>(i % 7);
+
+        std::vector<float> original = img;
+        std::vector<float> scratch(dwt_scratch_size(W, H));
+
+        dwt2_haar(img.data(), W, H, scratch.data());
+        dwt2_haar(alloc.data(), W, H);
+        reference_dwt2(ref.data(), W, H);
+
+        for (uint32_t i = 0; i < W * H; ++i) {
+            assert(img[i] == ref[i]);
+            assert(alloc[i] == ref[i]);
+        }
+
+        idwt2_haar(img.data(), W, H, scratch.data());
+        idwt2_haar(alloc.data(), W, H);
+        reference_idwt2(ref.data(), W, H);
+
+        for (uint32_t i = 0; i < W * H; ++i) {
+            assert(img[i] == ref[i]);
+            assert(alloc[i] == ref[i]);
+            assert(nearly_equal(img[i], original[i]));
+        }
+    }
+
+    printf("[PASS] DWT bit-identical to per-row reference\n");
+}
+
 // ----------------------------
 // Main
 // ----------------------------
 int main() {
     test_round_trip();
     test_constant_image();
+    test_matches_reference();
 
     printf("All DWT tests passed.\n");
     return 0;
@@ -130,12 +130,40 @@ void test_embed_extract_negative_bit() {
     printf("[PASS] Embed/extract bit -1\n");
 }
 
+// ----------------------------
+// Test: spatial pattern vs transform-domain embedding
+// ----------------------------
+void test_spatial_matches_transform() {
+    constexpr uint32_t STRIDE = 16;
+    float spatial[8 * STRIDE];
+    float transform[8 * STRIDE];
+
+    uint64_t key = 0x0F1E2D3C4B5A6978ULL;
+    float alpha = 2.0f;
+
+    for (uint32_t trial = 0; trial < 32; ++trial) {
+        for (uint32_t i = 0; i < 8 * STRIDE; ++i)
+            spatial[i] = transform[i] = float((i * 29 + trial * 7) % 200);
+
+        int8_t bit = (trial & 1) ? +1 : -1;
+
+        embed_bit_block(spatial, STRIDE, bit, key, trial, trial * 3, alpha);
+        embed_bit_block_transform(transform, STRIDE, bit, key, trial, trial * 3, alpha);
+
+        for (uint32_t i = 0; i < 8 * STRIDE; ++i)
+            assert(nearly_equal(spatial[i], transform[i]));
+    }
+
+    printf("[PASS] Spatial embed matches transform embed\n");
+}
+
 // ----------------------------
 // Main
 // ----------------------------
 int main() {
     test_embed_extract_single_block();
     test_embed_extract_negative_bit();
+    test_spatial_matches_transform();
 
     printf("All single-block embed/extract tests passed.\n");
     return 0;
@@ -0,0 +1,223 @@
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "wm/api.h"
+#include "wm/image.h"
+#include "wm/watermark/embed_image.h"
+#include "wm/watermark/embed_pixels.h"
+
+#include "test_fixtures.h"
+
+using namespace wm;
+using namespace wm_test;
+
+static constexpr uint8_t PAD = 0xAB;
+
+static const PixelFormat FORMATS[3] = {
+    PixelFormat::RGB8, PixelFormat::RGBA8, PixelFormat::BGRA8
+};
+
+// R, G, B offsets of a format
+static void offsets(PixelFormat f, uint32_t& r, uint32_t& g, uint32_t& b) {
+    r = f == PixelFormat::BGRA8 ? 2 : 0;
+    g = 1;
+    b = f == PixelFormat::BGRA8 ? 0 : 2;
+}
+
+// Textured colour image with padded rows (pad bytes = PAD)
+static std::vector<uint8_t> make_pixels(PixelFormat f, size_t pitch) {
+    const uint32_t bpp = bytes_per_pixel(f);
+    std::vector<uint8_t> px(pitch * H, PAD);
+
+    for (uint32_t y = 0; y < H; ++y)
+        for (uint32_t x = 0; x < W; ++x) {
+            uint8_t* p = &px[y * pitch + x * bpp];
+            float t = 0.5f + 0.5f * std::sin(0.012f * x + 0.009f * y);
+            p[0] = uint8_t(40 + 170 * t + (x * 7 + y * 3) % 3);
+            p[1] = uint8_t(255 * t * (1.0f - t) * 3.5f);
+            p[2] = uint8_t(120 + 60 * std::cos(0.02f * x - 0.015f * y));
+            if (bpp == 4)
+                p[3] = uint8_t(x ^ y);
+        }
+
+    return px;
+}
+
+// ----------------------------
+// Row conversions
+// ----------------------------
+void test_rows() {
+    for (PixelFormat f : FORMATS) {
+        const uint32_t bpp = bytes_per_pixel(f);
+        const uint32_t count = 37;   // SIMD body and scalar tail
+        uint32_t ro, go, bo;
+        offsets(f, ro, go, bo);
+
+        std::vector<uint8_t> px(count * bpp);
+        for (size_t i = 0; i < px.size(); ++i)
+            px[i] = uint8_t(i * 37 + 11);
+
+        std::vector<float> y(count);
+        luma_row(px.data(), f, count, y.data());
+
+        for (uint32_t i = 0; i < count; ++i) {
+            const uint8_t* p = &px[i * bpp];
+            float ref = 0.299f * p[ro] + 0.587f * p[go] + 0.114f * p[bo];
+            assert(std::fabs(y[i] - ref) < 1e-4f);
+        }
+
+        // Rounding, saturation, alpha untouched
+        std::vector<float> delta(count);
+        for (uint32_t i = 0; i < count; ++i)
+            delta[i] = (i % 2 ? 1.0f : -1.0f) * float(i % 9) * 37.3f + 0.4f;
+
+        std::vector<uint8_t> out = px;
+        add_luma_row(out.data(), f, count, delta.data());
+
+        for (uint32_t i = 0; i < count; ++i)
+            for (uint32_t c = 0; c < bpp; ++c) {
+                int before = px[i * bpp + c];
+                int after = out[i * bpp + c];
+
+                if (c == 3) {
+                    assert(after == before);
+                    continue;
+                }
+
+                float v = std::nearbyint(before + delta[i]);
+                int ref = v < 0.0f ? 0 : (v > 255.0f ? 255 : int(v));
+                assert(after == ref);
+            }
+    }
+
+    printf("[PASS] Luma rows\n");
+}
+
+// ----------------------------
+// Fused embed == Y plane + embed_image + write-back
+// ----------------------------
+void test_fused_matches_plane() {
+    int8_t bits[PAYLOAD_LEN];
+    make_bits(bits);
+
+    Plan plan;
+    assert(build_plan(plan, W, H, PAYLOAD_LEN, KEY));
+
+    for (PixelFormat f : FORMATS) {
+        const uint32_t bpp = bytes_per_pixel(f);
+        const size_t pitch = W * bpp + 24;
+
+        std::vector<uint8_t> fused = make_pixels(f, pitch);
+        std::vector<uint8_t> ref = fused;
+
+        PixelImage img{ W, H, pitch, f, fused.data() };
+        assert(embed_pixels(plan, img, bits, 2.5f, 3));
+
+        // Reference: whole float plane
+        std::vector<float> Y(W * H), Y0(W * H);
+        for (uint32_t y = 0; y < H; ++y)
+            luma_row(&ref[y * pitch], f, W, &Y[y * W]);
+        Y0 = Y;
+
+        Image plane{ W, H, Y.data() };
+        assert(embed_image(plan, plane, bits, 2.5f));
+
+        for (size_t i = 0; i < Y.size(); ++i)
+            Y[i] -= Y0[i];
+        for (uint32_t y = 0; y < H; ++y)
+            add_luma_row(&ref[y * pitch], f, W, &Y[y * W]);
+
+        assert(fused == ref);
+
+        // Row padding untouched
+        for (uint32_t y = 0; y < H; ++y)
+            for (size_t x = W * bpp; x < pitch; ++x)
+                assert(fused[y * pitch + x] == PAD);
+    }
+
+    printf("[PASS] Fused pixel embed matches the float plane\n");
+}
+
+// ----------------------------
+// C API: embed 8-bit, extract from its luminance
+// ----------------------------
+void test_pixels_api() {
+    int8_t bits[PAYLOAD_LEN];
+    make_bits(bits, PAYLOAD_LEN, 1);
+    WM_Payload payload{ bits, PAYLOAD_LEN };
+
+    WM_Context* ctx = nullptr;
+    assert(wm_context_create(W, H, PAYLOAD_LEN, KEY, nullptr, &ctx) ==
+           WM_OK);
+
+    const uint32_t formats[3] = { WM_PIXEL_RGB8, WM_PIXEL_RGBA8,
+                                  WM_PIXEL_BGRA8 };
+
+    for (uint32_t k = 0; k < 3; ++k) {
+        PixelFormat f = FORMATS[k];
+        const uint32_t bpp = bytes_per_pixel(f);
+        const uint32_t pitch = W * bpp + 64;
+
+        std::vector<uint8_t> a = make_pixels(f, pitch);
+        std::vector<uint8_t> b = a;
+
+        WM_PixelBuffer buf{ W, H, pitch, formats[k], a.data() };
+        assert(wm_embed_pixels(&buf, &payload, KEY, 3.0f, nullptr) == WM_OK);
+
+        WM_PixelBuffer buf_ctx{ W, H, pitch, formats[k], b.data() };
+        assert(wm_embed_pixels_ctx(ctx, &buf_ctx, &payload, 3.0f,
+                                   nullptr) == WM_OK);
+        assert(a == b);
+
+        // The watermark survives 8-bit quantization
+        std::vector<float> Y(W * H);
+        for (uint32_t y = 0; y < H; ++y)
+            luma_row(&a[y * pitch], f, W, &Y[y * W]);
+
+        int8_t out[PAYLOAD_LEN];
+        float conf[PAYLOAD_LEN];
+        WM_ExtractResult r{};
+        r.bits = out;
+        r.confidence = conf;
+        r.length = PAYLOAD_LEN;
+
+        WM_Image img{ W, H, Y.data() };
+        assert(wm_extract(&img, KEY, &r) == WM_OK);
+        assert(r.verdict == WM_VERDICT_VERIFIED);
+        for (uint32_t i = 0; i < PAYLOAD_LEN; ++i)
+            assert(out[i] == bits[i]);
+    }
+
+    // Argument checks
+    std::vector<uint8_t> px = make_pixels(PixelFormat::RGB8, W * 3);
+    WM_PixelBuffer buf{ W, H, W * 3, WM_PIXEL_RGB8, px.data() };
+
+    WM_PixelBuffer bad = buf;
+    bad.format = 7;
+    assert(wm_embed_pixels(&bad, &payload, KEY, 2.0f, nullptr) ==
+           WM_ERR_INVALID_ARGUMENT);
+
+    bad = buf;
+    bad.pitch = W * 3 - 1;
+    assert(wm_embed_pixels(&bad, &payload, KEY, 2.0f, nullptr) ==
+           WM_ERR_INVALID_ARGUMENT);
+
+    bad = buf;
+    bad.width = W - 8;
+    assert(wm_embed_pixels(&bad, &payload, KEY, 2.0f, nullptr) ==
+           WM_ERR_INVALID_DIMENSIONS);
+    assert(wm_embed_pixels_ctx(ctx, &bad, &payload, 2.0f, nullptr) ==
+           WM_ERR_INVALID_DIMENSIONS);
+
+    wm_context_destroy(ctx);
+    printf("[PASS] Pixel embedding API\n");
+}
+
+int main() {
+    test_rows();
+    test_fused_matches_plane();
+    test_pixels_api();
+    return 0;
+}
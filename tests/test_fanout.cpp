@@ -0,0 +1,135 @@
+#include <cassert>
+#include <cstdio>
+#include <vector>
+
+#include "wm/api.h"
+#include "wm/watermark/embed_image.h"
+#include "wm/watermark/fanout.h"
+
+#include "test_fixtures.h"
+
+using namespace wm;
+using namespace wm_test;
+
+static constexpr uint32_t COUNT = 5;
+static constexpr float ALPHA = 2.0f;
+
+// ----------------------------
+// Fan-out == embed_image on a copy
+// ----------------------------
+void test_fanout_matches_embed() {
+    const std::vector<float> src = smooth();
+
+    for (uint32_t v = 0; v < 2; ++v) {
+        Scheme scheme;
+        if (v)
+            scheme.permutation = PermutationScheme::Feistel;
+
+        Plan plan;
+        assert(build_plan(plan, W, H, PAYLOAD_LEN, KEY, scheme, v == 0));
+
+        int8_t bits[PAYLOAD_LEN];
+        make_bits(bits, PAYLOAD_LEN, 3);
+
+        std::vector<float> ref = src;
+        Image img{ W, H, ref.data() };
+        assert(embed_image(plan, img, bits, ALPHA));
+
+        std::vector<float> out(W * H);
+        fanout_embed(plan, src.data(), bits, ALPHA, out.data(), 2);
+
+        assert(max_diff(out.data(), ref.data(), out.size()) < 1e-3f);
+    }
+
+    printf("[PASS] Fan-out matches embed_image\n");
+}
+
+// ----------------------------
+// C API: caller buffers and callback
+// ----------------------------
+struct Collected {
+    uint32_t calls = 0;
+    std::vector<std::vector<float>> planes;
+};
+
+static void collect(uint32_t index, const float* y, void* user) {
+    Collected* c = static_cast<Collected*>(user);
+    assert(index == c->calls);
+    c->planes.emplace_back(y, y + W * H);
+    ++c->calls;
+}
+
+void test_fanout_api() {
+    const std::vector<float> src = smooth();
+
+    std::vector<int8_t> bits(COUNT * PAYLOAD_LEN);
+    std::vector<WM_Payload> payloads(COUNT);
+    for (uint32_t r = 0; r < COUNT; ++r) {
+        make_bits(&bits[r * PAYLOAD_LEN], PAYLOAD_LEN, r);
+        payloads[r] = { &bits[r * PAYLOAD_LEN], PAYLOAD_LEN };
+    }
+
+    WM_Context* ctx = nullptr;
+    assert(wm_context_create(W, H, PAYLOAD_LEN, KEY, nullptr, &ctx) == WM_OK);
+
+    // Caller buffers
+    std::vector<std::vector<float>> planes(COUNT, std::vector<float>(W * H));
+    std::vector<float*> outputs(COUNT);
+    for (uint32_t r = 0; r < COUNT; ++r)
+        outputs[r] = planes[r].data();
+
+    WM_EmbedOptions opts{};
+    opts.threads = 3;
+    assert(wm_embed_fanout(ctx, src.data(), payloads.data(), COUNT, ALPHA,
+                           &opts, outputs.data(), nullptr, nullptr) == WM_OK);
+
+    // Callback
+    Collected c;
+    assert(wm_embed_fanout(ctx, src.data(), payloads.data(), COUNT, ALPHA,
+                           nullptr, nullptr, collect, &c) == WM_OK);
+    assert(c.calls == COUNT);
+
+    for (uint32_t r = 0; r < COUNT; ++r) {
+        for (size_t i = 0; i < size_t(W) * H; ++i)
+            assert(planes[r][i] == c.planes[r][i]);
+
+        // Each recipient's own payload comes back
+        int8_t out[PAYLOAD_LEN];
+        float conf[PAYLOAD_LEN];
+        WM_ExtractResult result{};
+        result.bits = out;
+        result.confidence = conf;
+        result.length = PAYLOAD_LEN;
+
+        WM_Image img{ W, H, planes[r].data() };
+        assert(wm_extract_ctx(ctx, &img, &result, nullptr) == WM_OK);
+        assert(result.verdict == WM_VERDICT_VERIFIED);
+        for (uint32_t i = 0; i < PAYLOAD_LEN; ++i)
+            assert(out[i] == payloads[r].bits[i]);
+    }
+
+    // Argument checks
+    assert(wm_embed_fanout(ctx, src.data(), payloads.data(), COUNT, ALPHA,
+                           nullptr, nullptr, nullptr, nullptr) ==
+           WM_ERR_INVALID_ARGUMENT);
+
+    payloads[2].length = PAYLOAD_LEN + 1;
+    assert(wm_embed_fanout(ctx, src.data(), payloads.data(), COUNT, ALPHA,
+                           nullptr, outputs.data(), nullptr, nullptr) ==
+           WM_ERR_INVALID_ARGUMENT);
+
+    wm_context_destroy(ctx);
+
+    printf("[PASS] Fan-out API\n");
+}
+
+// ----------------------------
+// Main
+// ----------------------------
+int main() {
+    test_fanout_matches_embed();
+    test_fanout_api();
+
+    printf("All fan-out tests passed.\n");
+    return 0;
+}
@@ -0,0 +1,172 @@
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "wm/api.h"
+#include "wm/watermark/feature_file.h"
+
+#include "test_fixtures.h"
+
+using namespace wm_test;
+
+static const char* PATH = "test_feature_file.wmf";
+
+struct Extracted {
+    int8_t bits[32];
+    float conf[32];
+    WM_ExtractResult r{};
+
+    explicit Extracted(uint32_t length) {
+        r.bits = bits;
+        r.confidence = conf;
+        r.length = length;
+    }
+};
+
+static void assert_same(const WM_ExtractResult& a, const WM_ExtractResult& b) {
+    assert(a.length == b.length);
+    assert(a.verdict == b.verdict);
+    assert(a.mean_confidence == b.mean_confidence);
+    assert(a.min_confidence == b.min_confidence);
+    for (uint32_t i = 0; i < a.length; ++i) {
+        assert(a.bits[i] == b.bits[i]);
+        assert(a.confidence[i] == b.confidence[i]);
+    }
+}
+
+// Features give wm_extract_ex's result for any key and payload length
+static void check_against_image(const WM_Features* f, const WM_Image* img) {
+    for (uint64_t key : { KEY, KEY + 1 })
+        for (uint32_t len : { PAYLOAD_LEN, 32u }) {
+            Extracted a(len), b(len);
+            assert(wm_extract_ex(img, key, &a.r, nullptr) == WM_OK);
+            assert(wm_extract_features(f, key, &b.r, nullptr) == WM_OK);
+            assert_same(a.r, b.r);
+        }
+}
+
+// ----------------------------
+// Compute, serialize, reopen, map
+// ----------------------------
+void test_roundtrip() {
+    int8_t bits[PAYLOAD_LEN];
+    make_bits(bits);
+    WM_Payload payload{ bits, PAYLOAD_LEN };
+
+    std::vector<float> Y = textured();
+    WM_Image img{ W, H, Y.data() };
+    assert(wm_embed(&img, &payload, KEY, 2.0f) == WM_OK);
+
+    WM_Features* f = nullptr;
+    assert(wm_features_compute(&img, nullptr, &f) == WM_OK);
+    check_against_image(f, &img);
+
+    // 64-byte header, then 7 floats per block
+    const void* data = nullptr;
+    size_t size = 0;
+    assert(wm_features_bytes(f, &data, &size) == WM_OK);
+    assert(size == 64 + (W / 32) * (H / 32) * 2 * 7 * sizeof(float));
+    assert(size == wm::feature_file_size(W, H));
+
+    // In-memory view over a copy (float-aligned buffer)
+    std::vector<float> copy(size / sizeof(float));
+    std::memcpy(copy.data(), data, size);
+
+    WM_Features* view = nullptr;
+    assert(wm_features_open(copy.data(), size, &view) == WM_OK);
+    check_against_image(view, &img);
+
+    // Saved and mapped
+    assert(wm_features_save(f, PATH) == WM_OK);
+    WM_Features* mapped = nullptr;
+    assert(wm_features_map(PATH, &mapped) == WM_OK);
+    check_against_image(mapped, &img);
+
+    Extracted m(PAYLOAD_LEN);
+    assert(wm_extract_features(mapped, KEY, &m.r, nullptr) == WM_OK);
+    assert(m.r.verdict == WM_VERDICT_VERIFIED);
+    for (uint32_t i = 0; i < PAYLOAD_LEN; ++i)
+        assert(m.r.bits[i] == bits[i]);
+
+    // Context path
+    WM_Context* ctx = nullptr;
+    assert(wm_context_create(W, H, PAYLOAD_LEN, KEY, nullptr, &ctx) == WM_OK);
+    Extracted c(PAYLOAD_LEN);
+    assert(wm_extract_features_ctx(ctx, mapped, &c.r) == WM_OK);
+    assert_same(c.r, m.r);
+    wm_context_destroy(ctx);
+
+    WM_Context* other = nullptr;
+    assert(wm_context_create(W, H / 2, PAYLOAD_LEN, KEY, nullptr, &other) ==
+           WM_OK);
+    assert(wm_extract_features_ctx(other, mapped, &c.r) ==
+           WM_ERR_INVALID_DIMENSIONS);
+    wm_context_destroy(other);
+
+    wm_features_destroy(mapped);
+    wm_features_destroy(view);
+    wm_features_destroy(f);
+    std::remove(PATH);
+
+    printf("[PASS] Feature file roundtrip\n");
+}
+
+// ----------------------------
+// Malformed input is rejected
+// ----------------------------
+void test_rejects() {
+    std::vector<float> Y = textured();
+    WM_Image img{ W, H, Y.data() };
+
+    WM_Features* f = nullptr;
+    assert(wm_features_compute(&img, nullptr, &f) == WM_OK);
+
+    const void* data = nullptr;
+    size_t size = 0;
+    assert(wm_features_bytes(f, &data, &size) == WM_OK);
+
+    std::vector<float> copy(size / sizeof(float));
+    std::memcpy(copy.data(), data, size);
+    wm::FeatureFileHeader* h =
+        reinterpret_cast<wm::FeatureFileHeader*>(copy.data());
+
+    WM_Features* g = nullptr;
+    assert(wm_features_open(copy.data(), size - 4, &g) ==
+           WM_ERR_INVALID_ARGUMENT);
+    assert(g == nullptr);
+    assert(wm_features_open(copy.data(), 16, &g) == WM_ERR_INVALID_ARGUMENT);
+
+    h->version += 1;
+    assert(wm_features_open(copy.data(), size, &g) == WM_ERR_INVALID_ARGUMENT);
+    h->version -= 1;
+
+    h->byte_order = 0x04030201u;
+    assert(wm_features_open(copy.data(), size, &g) == WM_ERR_INVALID_ARGUMENT);
+    h->byte_order = wm::FEATURE_FILE_BYTE_ORDER;
+
+    h->magic[0] = 'X';
+    assert(wm_features_open(copy.data(), size, &g) == WM_ERR_INVALID_ARGUMENT);
+    h->magic[0] = 'W';
+
+    assert(wm_features_open(copy.data(), size, &g) == WM_OK);
+    wm_features_destroy(g);
+
+    assert(wm_features_map("/nonexistent/dir/features.wmf", &g) ==
+           WM_ERR_IO);
+    assert(wm_features_save(f, "/nonexistent/dir/features.wmf") ==
+           WM_ERR_IO);
+
+    WM_Image odd{ W - 16, H, Y.data() };
+    assert(wm_features_compute(&odd, nullptr, &g) ==
+           WM_ERR_INVALID_DIMENSIONS);
+
+    wm_features_destroy(f);
+    printf("[PASS] Feature file validation\n");
+}
+
+int main() {
+    test_roundtrip();
+    test_rejects();
+    return 0;
+}
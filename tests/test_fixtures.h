@@ -0,0 +1,54 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ----------------------------
+// Shared fixtures for the whole-image tests
+// ----------------------------
+// One geometry for every test: 16×16 tiles, 512 blocks, 32 per payload
+// bit. Tests that need another size pass it explicitly.
+namespace wm_test {
+
+constexpr uint32_t W = 512;
+constexpr uint32_t H = 512;
+constexpr uint32_t PAYLOAD_LEN = 16;
+constexpr uint64_t KEY = 0x5EED1234ULL;
+
+// Low-frequency luminance with little energy in the embedding band
+inline std::vector<float> smooth(uint32_t width = W, uint32_t height = H,
+                                 float phase = 0.0f) {
+    std::vector<float> Y(size_t(width) * height);
+    for (uint32_t y = 0; y < height; ++y)
+        for (uint32_t x = 0; x < width; ++x)
+            Y[size_t(y) * width + x] =
+                125.0f +
+                30.0f * std::sin(0.03f * x + phase) +
+                20.0f * std::cos(0.025f * y);
+    return Y;
+}
+
+// smooth() plus hashed per-pixel noise in [0, 16)
+inline std::vector<float> textured(uint32_t width = W, uint32_t height = H) {
+    std::vector<float> Y = smooth(width, height);
+    for (size_t i = 0; i < Y.size(); ++i)
+        Y[i] += float(uint32_t(i * 2654435761u) >> 28);
+    return Y;
+}
+
+// ±1 payload with both signs; different seeds give different payloads
+inline void make_bits(int8_t* bits, uint32_t n = PAYLOAD_LEN,
+                      uint32_t seed = 0) {
+    for (uint32_t i = 0; i < n; ++i)
+        bits[i] = ((i ^ (seed * 0x9E3779B9u)) * 2654435761u) >> 31 ? +1 : -1;
+}
+
+inline float max_diff(const float* a, const float* b, size_t n) {
+    float m = 0.0f;
+    for (size_t i = 0; i < n; ++i)
+        m = std::fmax(m, std::fabs(a[i] - b[i]));
+    return m;
+}
+
+} // namespace wm_test
@@ -0,0 +1,122 @@
+#include <cassert>
+#include <cstdio>
+#include <vector>
+
+#include "wm/api.h"
+#include "wm/watermark/embed_image.h"
+
+#include "test_fixtures.h"
+
+using namespace wm;
+using namespace wm_test;
+
+// ----------------------------
+// One layer == embed_image; two layers == two embeds
+// ----------------------------
+void test_layers_match_sequential() {
+    int8_t a[16], b[24];
+    make_bits(a, 16, 1);
+    make_bits(b, 24, 2);
+
+    Plan pa, pb;
+    assert(build_plan(pa, W, H, 16, 0xAAAAu));
+    assert(build_plan(pb, W, H, 24, 0xBBBBu));
+
+    std::vector<float> ref = smooth();
+    std::vector<float> out = smooth();
+    Image img_ref{ W, H, ref.data() };
+    Image img_out{ W, H, out.data() };
+
+    EmbedLayer one{ &pa, a, 2.0f };
+    assert(embed_image(pa, img_ref, a, 2.0f));
+    assert(embed_image_layers(img_out, &one, 1, 3));
+    assert(ref == out);
+
+    EmbedLayer two[2] = { { &pa, a, 2.0f }, { &pb, b, 1.5f } };
+    ref = smooth();
+    out = smooth();
+    img_ref.Y = ref.data();
+    img_out.Y = out.data();
+    assert(embed_image(pa, img_ref, a, 2.0f));
+    assert(embed_image(pb, img_ref, b, 1.5f));
+    assert(embed_image_layers(img_out, two, 2, 2));
+
+    float diff = max_diff(ref.data(), out.data(), ref.size());
+    assert(diff < 1e-3f);
+
+    // Plans must match the image
+    Plan small;
+    assert(build_plan(small, W / 2, H, 16, 1));
+    EmbedLayer bad[2] = { { &pa, a, 2.0f }, { &small, a, 2.0f } };
+    assert(!embed_image_layers(img_out, bad, 2));
+    assert(!embed_image_layers(img_out, bad, 0));
+
+    printf("[PASS] Layers match sequential embedding (max diff %g)\n",
+           diff);
+}
+
+// ----------------------------
+// C API: every layer verifies under its own key
+// ----------------------------
+void test_layers_api() {
+    constexpr uint32_t N = 3;
+    const uint64_t keys[N] = { 0x0111u, 0x0222u, 0x0333u };
+    const uint32_t lens[N] = { 16, 8, 12 };
+
+    int8_t bits[N][16];
+    WM_Payload payloads[N];
+    for (uint32_t l = 0; l < N; ++l) {
+        make_bits(bits[l], lens[l], l * 17);
+        payloads[l] = WM_Payload{ bits[l], lens[l] };
+    }
+
+    WM_Context* ctx = nullptr;
+    assert(wm_context_create(W, H, lens[2], keys[2], nullptr, &ctx) ==
+           WM_OK);
+
+    WM_EmbedLayer layers[N] = {
+        { keys[0], &payloads[0], 2.0f, nullptr },
+        { keys[1], &payloads[1], 2.0f, nullptr },
+        { 0,       &payloads[2], 2.0f, ctx },      // key from the context
+    };
+
+    std::vector<float> Y = smooth();
+    WM_Image img{ W, H, Y.data() };
+    assert(wm_embed_layers(&img, layers, N, nullptr) == WM_OK);
+
+    for (uint32_t l = 0; l < N; ++l) {
+        int8_t out[16];
+        float conf[16];
+        WM_ExtractResult r{};
+        r.bits = out;
+        r.confidence = conf;
+        r.length = lens[l];
+
+        assert(wm_extract(&img, keys[l], &r) == WM_OK);
+        assert(r.verdict == WM_VERDICT_VERIFIED);
+        for (uint32_t i = 0; i < lens[l]; ++i)
+            assert(out[i] == bits[l][i]);
+    }
+
+    // Argument checks
+    assert(wm_embed_layers(&img, layers, 0, nullptr) ==
+           WM_ERR_INVALID_ARGUMENT);
+
+    WM_Payload wrong_len{ bits[2], 5 };
+    WM_EmbedLayer bad = { 0, &wrong_len, 2.0f, ctx };
+    assert(wm_embed_layers(&img, &bad, 1, nullptr) ==
+           WM_ERR_INVALID_ARGUMENT);
+
+    WM_Image small{ W / 2, H, Y.data() };
+    assert(wm_embed_layers(&small, &layers[2], 1, nullptr) ==
+           WM_ERR_INVALID_DIMENSIONS);
+
+    wm_context_destroy(ctx);
+    printf("[PASS] Multi-layer embedding API\n");
+}
+
+int main() {
+    test_layers_match_sequential();
+    test_layers_api();
+    return 0;
+}
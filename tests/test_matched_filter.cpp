@@ -0,0 +1,117 @@
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "wm/api.h"
+#include "wm/watermark/embed_image.h"
+#include "wm/watermark/extract_image.h"
+
+#include "test_fixtures.h"
+
+using namespace wm;
+using namespace wm_test;
+
+// ----------------------------
+// Spatial templates == transform-domain correlations
+// ----------------------------
+void test_correlations_agree() {
+    int8_t bits[PAYLOAD_LEN];
+    make_bits(bits);
+
+    for (uint32_t v = 0; v < 2; ++v) {
+        Scheme scheme;
+        if (v) {
+            scheme.permutation = PermutationScheme::Feistel;
+            scheme.pn = PnScheme::Packed;
+        }
+
+        Plan plan;
+        assert(build_plan(plan, W, H, PAYLOAD_LEN, KEY, scheme));
+
+        // Before and after embedding
+        std::vector<float> Y = textured();
+        Image img{ W, H, Y.data() };
+
+        for (int marked = 0; marked < 2; ++marked) {
+            if (marked)
+                assert(embed_image(plan, img, bits, 2.0f));
+
+            std::vector<float> a(plan.layout.total_blocks);
+            std::vector<float> b(plan.layout.total_blocks);
+            assert(block_correlations(plan, img, a.data(),
+                                      ExtractMode::Transform));
+            assert(block_correlations(plan, img, b.data(),
+                                      ExtractMode::MatchedFilter, 3));
+
+            for (uint32_t p = 0; p < plan.layout.total_blocks; ++p) {
+                float tol = 1e-3f * (1.0f + std::fabs(a[p]));
+                assert(std::fabs(a[p] - b[p]) < tol);
+                if (plan.bit_of_block[p] == NO_BIT)
+                    assert(a[p] == 0.0f && b[p] == 0.0f);
+            }
+        }
+
+        int8_t out[PAYLOAD_LEN];
+        float conf[PAYLOAD_LEN];
+        assert(extract_image(plan, img, out, conf, 2,
+                             ExtractMode::MatchedFilter));
+        for (uint32_t i = 0; i < PAYLOAD_LEN; ++i)
+            assert(out[i] == bits[i]);
+    }
+
+    printf("[PASS] Matched filter agrees with transform domain\n");
+}
+
+// ----------------------------
+// C API mode selection
+// ----------------------------
+void test_matched_filter_api() {
+    int8_t bits[PAYLOAD_LEN];
+    make_bits(bits, PAYLOAD_LEN, 1);
+    WM_Payload payload{ bits, PAYLOAD_LEN };
+
+    std::vector<float> Y = textured();
+    WM_Image img{ W, H, Y.data() };
+    assert(wm_embed(&img, &payload, KEY, 2.0f) == WM_OK);
+
+    int8_t out[PAYLOAD_LEN];
+    float conf[PAYLOAD_LEN];
+    WM_ExtractResult result{};
+    result.bits = out;
+    result.confidence = conf;
+    result.length = PAYLOAD_LEN;
+
+    WM_ExtractOptions opts{};
+    opts.mode = WM_EXTRACT_MATCHED_FILTER;
+    assert(wm_extract_ex(&img, KEY, &result, &opts) == WM_OK);
+    assert(result.verdict == WM_VERDICT_VERIFIED);
+    for (uint32_t i = 0; i < PAYLOAD_LEN; ++i)
+        assert(out[i] == bits[i]);
+
+    WM_Context* ctx = nullptr;
+    assert(wm_context_create(W, H, PAYLOAD_LEN, KEY, nullptr, &ctx) == WM_OK);
+    assert(wm_extract_ctx(ctx, &img, &result, &opts) == WM_OK);
+    assert(result.verdict == WM_VERDICT_VERIFIED);
+
+    opts.mode = 9;
+    assert(wm_extract_ctx(ctx, &img, &result, &opts) ==
+           WM_ERR_INVALID_ARGUMENT);
+    assert(wm_extract_ex(&img, KEY, &result, &opts) ==
+           WM_ERR_INVALID_ARGUMENT);
+
+    wm_context_destroy(ctx);
+
+    printf("[PASS] Matched filter API\n");
+}
+
+// ----------------------------
+// Main
+// ----------------------------
+int main() {
+    test_correlations_agree();
+    test_matched_filter_api();
+
+    printf("All matched filter tests passed.\n");
+    return 0;
+}
@@ -0,0 +1,130 @@
+#include <cassert>
+#include <cstdio>
+#include <vector>
+
+#include "wm/api.h"
+#include "wm/watermark/extract_image.h"
+#include "wm/watermark/features.h"
+
+#include "test_fixtures.h"
+
+using namespace wm;
+using namespace wm_test;
+
+// ----------------------------
+// Features reproduce extract_image exactly
+// ----------------------------
+void test_features() {
+    std::vector<float> Y = textured();
+    Image img{ W, H, Y.data() };
+
+    std::vector<float> f1(feature_count(W, H));
+    std::vector<float> f4(feature_count(W, H));
+    assert(compute_features(img, f1.data(), 1));
+    assert(compute_features(img, f4.data(), 4));
+    assert(f1 == f4);
+
+    for (uint64_t key : { KEY, KEY + 1, KEY * 3 }) {
+        Plan plan;
+        assert(build_plan(plan, W, H, PAYLOAD_LEN, key));
+
+        int8_t bits_a[PAYLOAD_LEN], bits_b[PAYLOAD_LEN];
+        float conf_a[PAYLOAD_LEN], conf_b[PAYLOAD_LEN];
+        assert(extract_image(plan, img, bits_a, conf_a));
+        extract_features(plan, f1.data(), bits_b, conf_b);
+
+        for (uint32_t i = 0; i < PAYLOAD_LEN; ++i) {
+            assert(bits_a[i] == bits_b[i]);
+            assert(conf_a[i] == conf_b[i]);
+        }
+    }
+
+    Image odd{ W - 8, H, Y.data() };
+    assert(!compute_features(odd, f1.data()));
+
+    printf("[PASS] Features match extract_image\n");
+}
+
+// ----------------------------
+// Multi-key: per-key results and ranking
+// ----------------------------
+void test_multikey_api() {
+    int8_t bits[PAYLOAD_LEN];
+    make_bits(bits);
+    WM_Payload payload{ bits, PAYLOAD_LEN };
+
+    std::vector<float> Y = textured();
+    WM_Image img{ W, H, Y.data() };
+    assert(wm_embed(&img, &payload, KEY, 2.0f) == WM_OK);
+
+    constexpr uint32_t K = 6;
+    const uint64_t keys[K] = { 11, 22, KEY, 33, 44, 55 };
+    const uint32_t lens[K] = { PAYLOAD_LEN, PAYLOAD_LEN, PAYLOAD_LEN,
+                               32, PAYLOAD_LEN, 0 };
+
+    std::vector<int8_t> out(K * 32);
+    std::vector<float> conf(K * 32);
+    WM_ExtractResult results[K] = {};
+    for (uint32_t i = 0; i < K; ++i) {
+        results[i].bits = out.data() + i * 32;
+        results[i].confidence = conf.data() + i * 32;
+        results[i].length = lens[i];
+    }
+
+    uint32_t ranking[K];
+    WM_Status statuses[K];
+    assert(wm_extract_multikey(&img, keys, K, results, ranking, nullptr,
+                               statuses) == WM_OK);
+
+    // The marked key ranks first, the bad result last
+    assert(ranking[0] == 2);
+    assert(ranking[K - 1] == 5);
+    assert(statuses[5] == WM_ERR_INVALID_ARGUMENT);
+    assert(results[2].verdict == WM_VERDICT_VERIFIED);
+    for (uint32_t i = 0; i < PAYLOAD_LEN; ++i)
+        assert(results[2].bits[i] == bits[i]);
+
+    for (uint32_t r = 1; r + 1 < K; ++r)
+        assert(results[ranking[r - 1]].mean_confidence >=
+               results[ranking[r]].mean_confidence);
+
+    // Each result equals a separate wm_extract_ex
+    for (uint32_t i = 0; i < K - 1; ++i) {
+        assert(statuses[i] == WM_OK);
+
+        int8_t b[32];
+        float c[32];
+        WM_ExtractResult single{};
+        single.bits = b;
+        single.confidence = c;
+        single.length = lens[i];
+        assert(wm_extract_ex(&img, keys[i], &single, nullptr) == WM_OK);
+
+        assert(single.verdict == results[i].verdict);
+        assert(single.mean_confidence == results[i].mean_confidence);
+        for (uint32_t j = 0; j < lens[i]; ++j) {
+            assert(single.bits[j] == results[i].bits[j]);
+            assert(single.confidence[j] == results[i].confidence[j]);
+        }
+    }
+
+    // Argument checks
+    assert(wm_extract_multikey(&img, keys, 0, nullptr, nullptr, nullptr,
+                               nullptr) == WM_OK);
+    assert(wm_extract_multikey(&img, nullptr, K, results, ranking, nullptr,
+                               statuses) == WM_ERR_INVALID_ARGUMENT);
+
+    WM_Image odd{ W - 8, H, Y.data() };
+    assert(wm_extract_multikey(&odd, keys, K, results, ranking, nullptr,
+                               statuses) == WM_OK);
+    for (uint32_t i = 0; i < K; ++i)
+        assert(statuses[i] == WM_ERR_UNVERIFIABLE);
+
+    printf("[PASS] Multi-key extraction\n");
+}
+
+int main() {
+    test_features();
+    test_multikey_api();
+    return 0;
+}
@@ -0,0 +1,128 @@
+#include <cassert>
+#include <cstdio>
+#include <vector>
+
+#include "wm/api.h"
+#include "wm/watermark/embed_image.h"
+#include "wm/watermark/extract_image.h"
+#include "wm/watermark/pattern.h"
+
+#include "test_fixtures.h"
+
+using namespace wm;
+using namespace wm_test;
+
+static constexpr float ALPHA = 2.0f;
+
+// ----------------------------
+// Y + P == embed_image(Y)
+// ----------------------------
+void test_pattern_matches_embed() {
+    int8_t bits[PAYLOAD_LEN];
+    make_bits(bits);
+
+    Plan plan;
+    assert(build_plan(plan, W, H, PAYLOAD_LEN, KEY));
+
+    std::vector<float> ref = smooth();
+    Image ref_img{ W, H, ref.data() };
+    assert(embed_image(plan, ref_img, bits, ALPHA));
+
+    // Float32
+    Pattern pf;
+    assert(build_pattern(pf, plan, bits, ALPHA, PatternFormat::Float32, 2));
+    assert(pf.f32.size() == size_t(W) * H && pf.i16.empty());
+
+    std::vector<float> a = smooth();
+    Image a_img{ W, H, a.data() };
+    assert(apply_pattern(pf, a_img, 3));
+    assert(max_diff(a.data(), ref.data(), a.size()) < 1e-3f);
+
+    // Int16: within half a quantization step
+    Pattern pq;
+    assert(build_pattern(pq, plan, bits, ALPHA, PatternFormat::Int16));
+    assert(pq.i16.size() == size_t(W) * H && pq.f32.empty());
+    assert(pq.scale > 0.0f);
+
+    std::vector<float> b = smooth();
+    Image b_img{ W, H, b.data() };
+    assert(apply_pattern(pq, b_img));
+    assert(max_diff(b.data(), ref.data(), b.size()) < 0.5f * pq.scale + 1e-3f);
+
+    // Both still carry the payload
+    int8_t out[PAYLOAD_LEN];
+    float conf[PAYLOAD_LEN];
+    assert(extract_image(plan, b_img, out, conf));
+    for (uint32_t i = 0; i < PAYLOAD_LEN; ++i)
+        assert(out[i] == bits[i]);
+
+    // Size mismatch is rejected
+    Image wrong{ W, H - 32, b.data() };
+    assert(!apply_pattern(pf, wrong));
+
+    printf("[PASS] Pattern matches embed_image\n");
+}
+
+// ----------------------------
+// C API
+// ----------------------------
+void test_pattern_api() {
+    int8_t bits[PAYLOAD_LEN];
+    make_bits(bits);
+    WM_Payload payload{ bits, PAYLOAD_LEN };
+
+    WM_Context* ctx = nullptr;
+    assert(wm_context_create(W, H, PAYLOAD_LEN, KEY, nullptr, &ctx) == WM_OK);
+
+    WM_Pattern* pattern = nullptr;
+    assert(wm_pattern_create(ctx, &payload, ALPHA, 7, nullptr, &pattern) ==
+           WM_ERR_INVALID_ARGUMENT);
+    assert(pattern == nullptr);
+
+    WM_Payload short_payload{ bits, PAYLOAD_LEN - 1 };
+    assert(wm_pattern_create(ctx, &short_payload, ALPHA, WM_PATTERN_FLOAT32,
+                             nullptr, &pattern) == WM_ERR_INVALID_ARGUMENT);
+
+    assert(wm_pattern_create(ctx, &payload, ALPHA, WM_PATTERN_INT16,
+                             nullptr, &pattern) == WM_OK);
+
+    // Many renders, one pattern
+    for (int round = 0; round < 3; ++round) {
+        std::vector<float> Y = smooth();
+        WM_Image img{ W, H, Y.data() };
+        assert(wm_embed_pattern(pattern, &img, nullptr) == WM_OK);
+
+        int8_t out[PAYLOAD_LEN];
+        float conf[PAYLOAD_LEN];
+        WM_ExtractResult result{};
+        result.bits = out;
+        result.confidence = conf;
+        result.length = PAYLOAD_LEN;
+
+        assert(wm_extract_ctx(ctx, &img, &result, nullptr) == WM_OK);
+        assert(result.verdict == WM_VERDICT_VERIFIED);
+        for (uint32_t i = 0; i < PAYLOAD_LEN; ++i)
+            assert(out[i] == bits[i]);
+    }
+
+    std::vector<float> small(32 * 32, 0.0f);
+    WM_Image wrong{ 32, 32, small.data() };
+    assert(wm_embed_pattern(pattern, &wrong, nullptr) ==
+           WM_ERR_INVALID_DIMENSIONS);
+
+    wm_pattern_destroy(pattern);
+    wm_context_destroy(ctx);
+
+    printf("[PASS] Pattern API\n");
+}
+
+// ----------------------------
+// Main
+// ----------------------------
+int main() {
+    test_pattern_matches_embed();
+    test_pattern_api();
+
+    printf("All pattern tests passed.\n");
+    return 0;
+}
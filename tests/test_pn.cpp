@@ -1,22 +1,82 @@
 #include <cassert>
 #include <cstdio>
+#include <vector>
 #include "wm/watermark/pn.h"
 
 using namespace wm;
 
+// ----------------------------
+// v2: batch == scalar, range, balance
+// ----------------------------
+void test_pn_v2() {
+    uint64_t key = 987654321ULL;
+
+    const uint32_t N = 1003;  // exercises the scalar tail
+    std::vector<uint32_t> bits(N);
+    for (uint32_t i = 0; i < N; ++i)
+        bits[i] = (i * 7) % 64;
+
+    std::vector<uint8_t> masks(N);
+    pn_masks_v2(key, bits.data(), 500, N, masks.data());
+
+    uint32_t ones = 0;
+    for (uint32_t i = 0; i < N; ++i) {
+        assert(masks[i] == pn_mask_v2(key, bits[i], 500 + i));
+        assert(masks[i] < 128);
+        ones += __builtin_popcount(masks[i]);
+    }
+
+    // Chips are balanced: ~half of 7·N are +1
+    assert(ones > N * 7 * 45 / 100 && ones < N * 7 * 55 / 100);
+
+    // Determinism
+    assert(pn_mask_v2(key, 3, 9) == pn_mask_v2(key, 3, 9));
+
+    printf("[PASS] PN v2 packed masks\n");
+}
+
+// ----------------------------
+// v1 batch == scalar
+// ----------------------------
+void test_pn_batch() {
+    uint64_t key = 0xFEEDFACEULL;
+
+    const uint32_t N = 1003;  // exercises the scalar tail
+    std::vector<uint32_t> bits(N);
+    for (uint32_t i = 0; i < N; ++i)
+        bits[i] = (i * 11) % 48;
+
+    std::vector<uint8_t> masks(N);
+    pn_masks(key, bits.data(), 77, N, masks.data());
+
+    for (uint32_t i = 0; i < N; ++i)
+        assert(masks[i] == pn_mask(key, bits[i], 77 + i));
+
+    printf("[PASS] PN v1 batch masks\n");
+}
+
 int main() {
+    test_pn_v2();
+    test_pn_batch();
+
     uint64_t key = 123456789ULL;
 
     int8_t a = pn_chip(key, 0, 0, 0);
     int8_t b = pn_chip(key, 0, 0, 0);
-    int8_t c = pn_chip(key, 0, 1, 0);
-    int8_t d = pn_chip(key, 1, 0, 0);
 
     // Determinism
     assert(a == b);
 
-    // Sensitivity
-    assert(a != c || a != d);
+    // Sensitivity: a single chip matches with probability 1/2, so compare
+    // whole runs of blocks instead of one pair
+    uint32_t block_changes = 0;
+    uint32_t bit_changes = 0;
+    for (uint32_t i = 0; i < 64; ++i) {
+        int8_t base = pn_chip(key, 0, i, 0);
+        block_changes += base != pn_chip(key, 0, i + 64, 0);
+        bit_changes += base != pn_chip(key, 1, i, 0);
+    }
+    assert(block_changes > 0 && bit_changes > 0);
 
     // Range
     assert(a == 1 || a == -1);
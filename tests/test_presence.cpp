@@ -0,0 +1,99 @@
+#include <cassert>
+#include <cstdio>
+#include <vector>
+
+#include "wm/api.h"
+#include "wm/watermark/presence.h"
+
+#include "test_fixtures.h"
+
+using namespace wm;
+using namespace wm_test;
+
+// ----------------------------
+// χ² tail bound
+// ----------------------------
+void test_tail_bound() {
+    assert(chi2_tail_bound(10.0, 16) == 1.0);
+    assert(chi2_tail_bound(16.0, 16) == 1.0);
+
+    // Decreasing in t, and above the exact tail (P(χ²_16 ≥ 40) ≈ 7.7e-4)
+    double prev = 1.0;
+    for (double t = 17.0; t < 200.0; t += 7.0) {
+        double b = chi2_tail_bound(t, 16);
+        assert(b < prev && b > 0.0);
+        prev = b;
+    }
+    assert(chi2_tail_bound(40.0, 16) > 7.7e-4);
+
+    printf("[PASS] Chi-square tail bound\n");
+}
+
+// ----------------------------
+// Marked vs unmarked vs wrong key
+// ----------------------------
+void test_presence_api() {
+    int8_t bits[PAYLOAD_LEN];
+    make_bits(bits);
+    WM_Payload payload{ bits, PAYLOAD_LEN };
+
+    std::vector<float> clean = textured();
+    std::vector<float> Y = clean;
+    WM_Image img{ W, H, Y.data() };
+    WM_Image img_clean{ W, H, clean.data() };
+    assert(wm_embed(&img, &payload, KEY, 2.0f) == WM_OK);
+
+    const uint32_t total = (W / 32) * (H / 32) * 2;
+
+    WM_PresenceResult r{};
+    assert(wm_detect_presence(&img, KEY, PAYLOAD_LEN, nullptr, nullptr,
+                              &r) == WM_OK);
+    assert(r.blocks_read == PAYLOAD_LEN * 4);
+    assert(r.blocks_read * 4 <= total);
+    assert(r.score > 5.0f);
+    // 16 bits × 4 blocks cap T at 64, so the bound cannot go much lower
+    assert(r.false_positive_bound < 1e-4f);
+
+    // Context path agrees with the key path
+    WM_Context* ctx = nullptr;
+    assert(wm_context_create(W, H, PAYLOAD_LEN, KEY, nullptr, &ctx) == WM_OK);
+    WM_PresenceResult rc{};
+    assert(wm_detect_presence_ctx(ctx, &img, nullptr, &rc) == WM_OK);
+    assert(rc.score == r.score);
+    assert(rc.false_positive_bound == r.false_positive_bound);
+
+    // Unmarked image and wrong keys: no detection
+    assert(wm_detect_presence_ctx(ctx, &img_clean, nullptr, &rc) == WM_OK);
+    assert(rc.false_positive_bound > 1e-3f);
+
+    for (uint64_t k = 1; k <= 16; ++k) {
+        assert(wm_detect_presence(&img, KEY ^ (k * 0x9E3779B97F4A7C15ULL),
+                                  PAYLOAD_LEN, nullptr, nullptr,
+                                  &r) == WM_OK);
+        assert(r.false_positive_bound > 1e-3f);
+    }
+
+    // More blocks per bit, capped at the plan's
+    WM_PresenceOptions all{ 1000 };
+    assert(wm_detect_presence_ctx(ctx, &img, &all, &rc) == WM_OK);
+    assert(rc.blocks_read <= total);
+    assert(rc.false_positive_bound < 1e-12f);
+
+    // Argument checks
+    assert(wm_detect_presence(&img, KEY, 0, nullptr, nullptr, &r) ==
+           WM_ERR_INVALID_ARGUMENT);
+    assert(wm_detect_presence_ctx(ctx, &img, nullptr, nullptr) ==
+           WM_ERR_INVALID_ARGUMENT);
+    WM_Image small{ W / 2, H, Y.data() };
+    assert(wm_detect_presence_ctx(ctx, &small, nullptr, &rc) ==
+           WM_ERR_INVALID_DIMENSIONS);
+
+    wm_context_destroy(ctx);
+    printf("[PASS] Presence pre-screen\n");
+}
+
+int main() {
+    test_tail_bound();
+    test_presence_api();
+    return 0;
+}
@@ -0,0 +1,129 @@
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "wm/api.h"
+#include "wm/watermark/embed_image.h"
+#include "wm/watermark/extract_image.h"
+
+#include "test_fixtures.h"
+
+using namespace wm;
+using namespace wm_test;
+
+// ----------------------------
+// Scores: sign = bit, scale-free normalization
+// ----------------------------
+void test_soft_scores() {
+    int8_t bits[PAYLOAD_LEN];
+    make_bits(bits);
+
+    Plan plan;
+    assert(build_plan(plan, W, H, PAYLOAD_LEN, KEY));
+
+    std::vector<float> Y = textured();
+    Image img{ W, H, Y.data() };
+    assert(embed_image(plan, img, bits, 2.0f));
+
+    int8_t out[PAYLOAD_LEN];
+    float conf[PAYLOAD_LEN];
+    float z[PAYLOAD_LEN];
+    assert(extract_image_soft(plan, img, out, conf, z, 2));
+
+    for (uint32_t i = 0; i < PAYLOAD_LEN; ++i) {
+        assert(out[i] == bits[i]);
+        assert((z[i] > 0.0f) == (bits[i] > 0));
+        assert(conf[i] > 0.9f && conf[i] <= 1.0f);
+    }
+
+    // Scaling the image scales every correlation: z is unchanged
+    for (float& v : Y)
+        v *= 0.5f;
+
+    float z_half[PAYLOAD_LEN];
+    assert(extract_image_soft(plan, img, out, conf, z_half));
+    for (uint32_t i = 0; i < PAYLOAD_LEN; ++i)
+        assert(std::fabs(z_half[i] - z[i]) < 1e-3f * (1.0f + std::fabs(z[i])));
+
+    printf("[PASS] Soft scores\n");
+}
+
+// ----------------------------
+// C API: extended result
+// ----------------------------
+static WM_ExtractResultSoft soft_result(int8_t* out, float* conf, float* z) {
+    WM_ExtractResultSoft r{};
+    r.base.bits = out;
+    r.base.confidence = conf;
+    r.base.length = PAYLOAD_LEN;
+    r.struct_size = sizeof(WM_ExtractResultSoft);
+    r.scores = z;
+    return r;
+}
+
+void test_soft_api() {
+    int8_t bits[PAYLOAD_LEN];
+    make_bits(bits);
+    WM_Payload payload{ bits, PAYLOAD_LEN };
+
+    std::vector<float> Y = textured();
+    WM_Image img{ W, H, Y.data() };
+    assert(wm_embed(&img, &payload, KEY, 2.0f) == WM_OK);
+
+    int8_t out[PAYLOAD_LEN];
+    float conf[PAYLOAD_LEN];
+    float z[PAYLOAD_LEN];
+
+    // Marked image
+    WM_ExtractResultSoft r = soft_result(out, conf, z);
+    assert(wm_extract_soft(&img, KEY, &r, nullptr) == WM_OK);
+    assert(r.base.verdict == WM_VERDICT_VERIFIED);
+    // z is at most sqrt(blocks_per_bit) = sqrt(32) here
+    assert(r.min_abs_score > 1.5f);
+    assert(r.detection_z > 8.0f);
+    for (uint32_t i = 0; i < PAYLOAD_LEN; ++i)
+        assert(out[i] == bits[i]);
+
+    // Context call agrees; scores may be omitted
+    WM_Context* ctx = nullptr;
+    assert(wm_context_create(W, H, PAYLOAD_LEN, KEY, nullptr, &ctx) == WM_OK);
+
+    WM_ExtractResultSoft rc = soft_result(out, conf, nullptr);
+    assert(wm_extract_soft_ctx(ctx, &img, &rc, nullptr) == WM_OK);
+    assert(rc.mean_abs_score == r.mean_abs_score);
+    assert(rc.detection_z == r.detection_z);
+
+    // Wrong key: no evidence
+    WM_ExtractResultSoft rw = soft_result(out, conf, z);
+    assert(wm_extract_soft(&img, KEY ^ 0x1234, &rw, nullptr) == WM_OK);
+    assert(rw.base.verdict != WM_VERDICT_VERIFIED);
+    assert(rw.detection_z < 6.0f);
+
+    // The base struct still works with the hard-decision calls
+    assert(wm_extract(&img, KEY, &r.base) == WM_OK);
+    assert(r.base.verdict == WM_VERDICT_VERIFIED);
+
+    // Size guard
+    WM_ExtractResultSoft bad = soft_result(out, conf, z);
+    bad.struct_size = sizeof(WM_ExtractResult);
+    assert(wm_extract_soft(&img, KEY, &bad, nullptr) ==
+           WM_ERR_INVALID_ARGUMENT);
+    assert(wm_extract_soft_ctx(ctx, &img, &bad, nullptr) ==
+           WM_ERR_INVALID_ARGUMENT);
+
+    wm_context_destroy(ctx);
+
+    printf("[PASS] Soft result API\n");
+}
+
+// ----------------------------
+// Main
+// ----------------------------
+int main() {
+    test_soft_scores();
+    test_soft_api();
+
+    printf("All soft-decision tests passed.\n");
+    return 0;
+}
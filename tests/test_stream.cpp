@@ -0,0 +1,198 @@
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "wm/api.h"
+#include "wm/image.h"
+#include "wm/watermark/embed_image.h"
+#include "wm/watermark/extract_image.h"
+#include "wm/watermark/stream.h"
+
+#include "test_fixtures.h"
+
+using namespace wm;
+using namespace wm_test;
+
+// ----------------------------
+// Streamed embed == whole-image embed
+// ----------------------------
+void test_stream_embed_matches_whole() {
+    int8_t payload[PAYLOAD_LEN];
+    make_bits(payload);
+
+    std::vector<float> whole = textured();
+    std::vector<float> streamed = whole;
+
+    Image img{ W, H, whole.data() };
+    assert(embed_image(img, payload, PAYLOAD_LEN, KEY, 2.0f));
+
+    EmbedStream s;
+    assert(embed_stream_begin(s, W, H, payload, PAYLOAD_LEN, KEY, 2.0f));
+
+    // v1 keeps only the bit of each block
+    assert(s.plan.block_of_slot.empty() && s.plan.pn_signs.empty());
+    assert(s.plan.bit_of_block.size() == s.plan.layout.total_blocks);
+
+    // Each band goes through a separate decoder-sized buffer
+    std::vector<float> band(W * STREAM_BAND_ROWS);
+    for (uint32_t y = 0; y < H; y += STREAM_BAND_ROWS) {
+        float* rows = streamed.data() + y * W;
+        std::memcpy(band.data(), rows, band.size() * sizeof(float));
+        assert(embed_stream_push(s, band.data()));
+        std::memcpy(rows, band.data(), band.size() * sizeof(float));
+    }
+
+    assert(embed_stream_complete(s));
+    assert(!embed_stream_push(s, band.data()));
+
+    assert(std::memcmp(whole.data(), streamed.data(),
+                       whole.size() * sizeof(float)) == 0);
+
+    printf("[PASS] Streamed embed matches whole-image embed\n");
+}
+
+// ----------------------------
+// Streamed extraction == whole-image extraction
+// ----------------------------
+void test_stream_extract_matches_whole() {
+    int8_t payload[PAYLOAD_LEN];
+    make_bits(payload);
+
+    std::vector<float> Y = textured();
+
+    Image img{ W, H, Y.data() };
+    assert(embed_image(img, payload, PAYLOAD_LEN, KEY, 2.0f));
+
+    int8_t bits_ref[PAYLOAD_LEN];
+    float conf_ref[PAYLOAD_LEN];
+    assert(extract_image(img, bits_ref, conf_ref, PAYLOAD_LEN, KEY));
+
+    ExtractStream s;
+    assert(extract_stream_begin(s, W, H, PAYLOAD_LEN, KEY));
+
+    int8_t bits[PAYLOAD_LEN];
+    float conf[PAYLOAD_LEN];
+
+    for (uint32_t y = 0; y < H; y += STREAM_BAND_ROWS) {
+        // Not finished until every band has arrived
+        assert(!extract_stream_finish(s, bits, conf));
+        assert(extract_stream_push(s, Y.data() + y * W));
+    }
+
+    assert(extract_stream_finish(s, bits, conf));
+
+    for (uint32_t i = 0; i < PAYLOAD_LEN; ++i) {
+        assert(bits[i] == bits_ref[i]);
+        assert(bits[i] == payload[i]);
+        assert(conf[i] == conf_ref[i]);
+    }
+
+    printf("[PASS] Streamed extraction matches whole-image extraction\n");
+}
+
+// ----------------------------
+// Table-free (Feistel) streams match the whole-image path
+// ----------------------------
+void test_stream_feistel() {
+    int8_t payload[PAYLOAD_LEN];
+    make_bits(payload);
+
+    Scheme scheme;
+    scheme.permutation = PermutationScheme::Feistel;
+
+    std::vector<float> whole = textured();
+    std::vector<float> streamed = whole;
+
+    Plan plan;
+    assert(build_plan(plan, W, H, PAYLOAD_LEN, KEY, scheme));
+
+    Image img{ W, H, whole.data() };
+    assert(embed_image(plan, img, payload, 2.0f));
+
+    EmbedStream es;
+    assert(embed_stream_begin(es, W, H, payload, PAYLOAD_LEN, KEY, 2.0f,
+                              scheme));
+    assert(es.plan.bit_of_block.empty());
+
+    for (uint32_t y = 0; y < H; y += STREAM_BAND_ROWS)
+        assert(embed_stream_push(es, streamed.data() + y * W));
+
+    assert(whole == streamed);
+
+    int8_t bits_ref[PAYLOAD_LEN], bits[PAYLOAD_LEN];
+    float conf_ref[PAYLOAD_LEN], conf[PAYLOAD_LEN];
+    assert(extract_image(plan, img, bits_ref, conf_ref));
+
+    ExtractStream xs;
+    assert(extract_stream_begin(xs, W, H, PAYLOAD_LEN, KEY, scheme));
+    for (uint32_t y = 0; y < H; y += STREAM_BAND_ROWS)
+        assert(extract_stream_push(xs, streamed.data() + y * W));
+    assert(extract_stream_finish(xs, bits, conf));
+
+    for (uint32_t i = 0; i < PAYLOAD_LEN; ++i) {
+        assert(bits[i] == bits_ref[i] && bits[i] == payload[i]);
+        assert(conf[i] == conf_ref[i]);
+    }
+
+    printf("[PASS] Table-free Feistel streams\n");
+}
+
+// ----------------------------
+// C ABI round trip
+// ----------------------------
+void test_stream_abi() {
+    int8_t bits_in[PAYLOAD_LEN];
+    make_bits(bits_in);
+
+    std::vector<float> Y = textured();
+
+    WM_Payload payload{ bits_in, PAYLOAD_LEN };
+
+    WM_EmbedStream* es = nullptr;
+    assert(wm_embed_stream_create(W, H, &payload, KEY, 2.0f, nullptr, &es) ==
+           WM_OK);
+    for (uint32_t y = 0; y < H; y += WM_STREAM_BAND_ROWS)
+        assert(wm_embed_stream_push(es, Y.data() + y * W) == WM_OK);
+    wm_embed_stream_destroy(es);
+
+    WM_ExtractStream* xs = nullptr;
+    assert(wm_extract_stream_create(W, H, PAYLOAD_LEN, KEY, nullptr, &xs) ==
+           WM_OK);
+    for (uint32_t y = 0; y < H; y += WM_STREAM_BAND_ROWS)
+        assert(wm_extract_stream_push(xs, Y.data() + y * W) == WM_OK);
+
+    int8_t bits[PAYLOAD_LEN];
+    float conf[PAYLOAD_LEN];
+    WM_ExtractResult result{};
+    result.bits = bits;
+    result.confidence = conf;
+    result.length = PAYLOAD_LEN;
+
+    assert(wm_extract_stream_finish(xs, &result) == WM_OK);
+    wm_extract_stream_destroy(xs);
+
+    for (uint32_t i = 0; i < PAYLOAD_LEN; ++i)
+        assert(bits[i] == bits_in[i]);
+    assert(result.verdict == WM_VERDICT_VERIFIED);
+
+    // Invalid geometry is rejected up front
+    assert(wm_embed_stream_create(W + 8, H, &payload, KEY, 2.0f, nullptr,
+                                  &es) == WM_ERR_INVALID_DIMENSIONS);
+    assert(es == nullptr);
+
+    printf("[PASS] Streaming C ABI round trip\n");
+}
+
+// ----------------------------
+// Main
+// ----------------------------
+int main() {
+    test_stream_embed_matches_whole();
+    test_stream_extract_matches_whole();
+    test_stream_feistel();
+    test_stream_abi();
+
+    printf("All stream tests passed.\n");
+    return 0;
+}
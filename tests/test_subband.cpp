@@ -138,6 +138,57 @@ void test_both_edge() {
     printf("[PASS] Horizontal edge  ~ LH energy\n");
 }
 
+// ----------------------------
+// Direct HL2/LH2 vs full DWT
+// ----------------------------
+void test_direct_detail_matches_dwt() {
+    const uint32_t W = 96, H = 64;
+    std::vector<float> img(W * H);
+
+    for (uint32_t y = 0; y < H; ++y)
+        for (uint32_t x = 0; x < W; ++x)
+            img[y * W + x] = float((x * 37 + y * 91 + x * y) % 256);
+
+    const std::vector<float> original = img;
+
+    std::vector<float> hl_direct((W / 4) * (H / 4));
+    std::vector<float> lh_direct((W / 4) * (H / 4));
+    haar_detail2(img.data(), W, H, hl_direct.data(), lh_direct.data());
+
+    // Input is left untouched
+    assert(img == original);
+
+    // Per tile: the same values as the matching 8×8 of the full strips
+    for (uint32_t ty = 0; ty < H / 32; ++ty)
+        for (uint32_t tx = 0; tx < W / 32; ++tx) {
+            float hl_tile[64], lh_tile[64];
+            haar_detail2_tile(&img[ty * 32 * W + tx * 32], W,
+                              hl_tile, lh_tile);
+
+            for (uint32_t y = 0; y < 8; ++y)
+                for (uint32_t x = 0; x < 8; ++x) {
+                    uint32_t i = (ty * 8 + y) * (W / 4) + tx * 8 + x;
+                    assert(hl_tile[y * 8 + x] == hl_direct[i]);
+                    assert(lh_tile[y * 8 + x] == lh_direct[i]);
+                }
+        }
+
+    dwt2_haar(img.data(), W, H);
+
+    auto hl = HL2(img.data(), W, H);
+    auto lh = LH2(img.data(), W, H);
+
+    for (uint32_t y = 0; y < hl.height; ++y)
+        for (uint32_t x = 0; x < hl.width; ++x) {
+            assert(nearly_equal(hl.data[y * hl.stride + x],
+                                hl_direct[y * hl.width + x]));
+            assert(nearly_equal(lh.data[y * lh.stride + x],
+                                lh_direct[y * lh.width + x]));
+        }
+
+    printf("[PASS] Direct HL2/LH2 match DWT\n");
+}
+
 // ----------------------------
 // Main
 // ----------------------------
@@ -145,6 +196,7 @@ int main() {
     test_subband_dimensions();
     test_constant_image_subbands();
     test_both_edge();
+    test_direct_detail_matches_dwt();
 
     printf("All subband tests passed.\n");
     return 0;
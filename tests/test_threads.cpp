@@ -0,0 +1,170 @@
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include "wm/api.h"
+#include "wm/thread_pool.h"
+
+using namespace wm;
+
+// ----------------------------
+// Every index runs exactly once
+// ----------------------------
+void test_parallel_for_covers_range() {
+    ThreadPool pool(3);
+    assert(pool.concurrency() == 4);
+
+    const uint32_t N = 1000;
+    std::vector<std::atomic<uint32_t>> hits(N);
+    for (auto& h : hits)
+        h = 0;
+
+    for (uint32_t threads : { 1u, 2u, 4u, 0u }) {
+        pool.parallel_for(N, threads, [&](uint32_t i) { hits[i]++; });
+    }
+
+    for (uint32_t i = 0; i < N; ++i)
+        assert(hits[i] == 4);
+
+    printf("[PASS] parallel_for covers every index once\n");
+}
+
+// ----------------------------
+// Nested calls from workers complete
+// ----------------------------
+void test_parallel_for_nested() {
+    ThreadPool pool(2);
+
+    std::atomic<uint32_t> total{ 0 };
+    pool.parallel_for(8, 0, [&](uint32_t) {
+        pool.parallel_for(16, 0, [&](uint32_t) { total++; });
+    });
+
+    assert(total == 8 * 16);
+
+    printf("[PASS] Nested parallel_for\n");
+}
+
+// ----------------------------
+// Exceptions reach the caller after helpers finish
+// ----------------------------
+void test_parallel_for_exception() {
+    ThreadPool pool(3);
+
+    const uint32_t N = 256;
+    std::vector<uint32_t> order(N);
+    for (uint32_t i = 0; i < N; ++i)
+        order[i] = i;
+
+    // Throw from an index every slot may draw, including the caller's
+    for (uint32_t bad : { 0u, 1u, 77u, N - 1 }) {
+        for (int stealing = 0; stealing < 2; ++stealing) {
+            std::atomic<uint32_t> running{ 0 };
+            bool caught = false;
+
+            auto fn = [&](uint32_t i) {
+                running++;
+                std::this_thread::yield();
+                running--;
+                if (i == bad)
+                    throw std::runtime_error("task failed");
+            };
+
+            try {
+                if (stealing)
+                    pool.parallel_for_stealing(order.data(), N, 4, fn);
+                else
+                    pool.parallel_for(N, 4, fn);
+            } catch (const std::runtime_error&) {
+                caught = true;
+            }
+
+            assert(caught);
+            assert(running == 0);
+        }
+    }
+
+    // The pool is still usable afterwards
+    std::atomic<uint32_t> total{ 0 };
+    pool.parallel_for(N, 4, [&](uint32_t) { total++; });
+    assert(total == N);
+
+    printf("[PASS] Task exceptions rethrown on the caller\n");
+}
+
+// ----------------------------
+// Results independent of thread count
+// ----------------------------
+void test_thread_count_bit_identical() {
+    const uint32_t W = 256, H = 192, PAYLOAD_LEN = 16;
+    const uint64_t KEY = 0xFACEB00CULL;
+
+    int8_t bits[PAYLOAD_LEN];
+    for (uint32_t i = 0; i < PAYLOAD_LEN; ++i)
+        bits[i] = (i % 3) ? +1 : -1;
+
+    WM_Payload payload{ bits, PAYLOAD_LEN };
+
+    std::vector<float> source(W * H);
+    for (uint32_t y = 0; y < H; ++y)
+        for (uint32_t x = 0; x < W; ++x)
+            source[y * W + x] =
+                100.0f +
+                30.0f * std::sin(0.04f * x) +
+                20.0f * std::cos(0.03f * y);
+
+    std::vector<float> reference;
+    std::vector<float> conf_reference;
+
+    for (uint32_t threads : { 1u, 2u, 3u, 8u, 0u, WM_THREADS_ALL }) {
+        std::vector<float> Y = source;
+        WM_Image img{ W, H, Y.data() };
+
+        WM_EmbedOptions eopt{};
+        eopt.strength_scale = 1.0f;
+        eopt.threads = threads;
+        assert(wm_embed_ex(&img, &payload, KEY, 2.0f, &eopt) == WM_OK);
+
+        int8_t out[PAYLOAD_LEN];
+        std::vector<float> conf(PAYLOAD_LEN);
+        WM_ExtractResult result{};
+        result.bits = out;
+        result.confidence = conf.data();
+        result.length = PAYLOAD_LEN;
+
+        WM_ExtractOptions xopt{};
+        xopt.threads = threads;
+        assert(wm_extract_ex(&img, KEY, &result, &xopt) == WM_OK);
+
+        for (uint32_t i = 0; i < PAYLOAD_LEN; ++i)
+            assert(out[i] == bits[i]);
+
+        if (reference.empty()) {
+            reference = Y;
+            conf_reference = conf;
+        } else {
+            assert(std::memcmp(Y.data(), reference.data(),
+                               Y.size() * sizeof(float)) == 0);
+            assert(conf == conf_reference);
+        }
+    }
+
+    printf("[PASS] Results identical for every thread count\n");
+}
+
+// ----------------------------
+// Main
+// ----------------------------
+int main() {
+    test_parallel_for_covers_range();
+    test_parallel_for_nested();
+    test_parallel_for_exception();
+    test_thread_count_bit_identical();
+
+    printf("All thread tests passed.\n");
+    return 0;
+}